@@ -2,7 +2,8 @@
 """
 Script to check if C++ files contain the @Component or @Service annotation above class declarations that inherit from interfaces.
 Validates that class inherits from interface and has @Component or @Service annotation.
-@Service is treated as an alias for @Component.
+@Service is treated as an alias for @Component, and so is @RestController when the web stage
+does not rewrite it into @Component (--generated-dir).
 
 This script:
 1. Finds @Component or @Service annotations (/* @Component */, /* @Service */, or /*@Component*/, /*@Service*/) that are not processed
@@ -19,11 +20,14 @@ from typing import List, Dict, Optional, Tuple, Set
 try:
     from find_class_names import find_class_names
     from find_interface_names import find_interface_names
+    from codegen_parallel import write_file_atomic
+    import source_index
 except ImportError:
     # print("Error: Could not import required modules. Make sure find_class_names.py and find_interface_names.py are in the same directory.")
     sys.exit(1)
 
 
+@source_index.cached_query
 def find_component_macros(file_path: str) -> List[Dict[str, str]]:
     """
     Find all @Component or @Service annotations in a C++ file and their context.
@@ -38,8 +42,7 @@ def find_component_macros(file_path: str) -> List[Dict[str, str]]:
     component_macros = []
     
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return []
@@ -52,10 +55,11 @@ def find_component_macros(file_path: str) -> List[Dict[str, str]]:
     component_annotation_pattern = re.compile(r'/\*\s*@Component\s*\*/')
     component_processed_pattern = re.compile(r'/\*--\s*@Component\s*--\*/')
     
-    # Pattern to match @Service annotation (alias for @Component)
+    # Pattern to match @Service annotation (alias for @Component), and @RestController when
+    # the web stage left it in place (--generated-dir)
     # Also check for already processed /*--@Service--*/ pattern
-    service_annotation_pattern = re.compile(r'/\*\s*@Service\s*\*/')
-    service_processed_pattern = re.compile(r'/\*--\s*@Service\s*--\*/')
+    service_annotation_pattern = re.compile(r'/\*\s*@(Service|RestController)\s*\*/')
+    service_processed_pattern = re.compile(r'/\*--\s*@(Service|RestController)\s*--\*/')
     
     # Pattern to match class declarations
     class_pattern = r'class\s+([A-Za-z_][A-Za-z0-9_]*)\s*(?:[:{])'
@@ -175,13 +179,12 @@ def check_component_macro_exists(file_path: str) -> bool:
         True if active @Component or @Service annotation or COMPONENT macro is found, False otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
         
         component_annotation_pattern = re.compile(r'/\*\s*@Component\s*\*/')
         component_processed_pattern = re.compile(r'/\*--\s*@Component\s*--\*/')
-        service_annotation_pattern = re.compile(r'/\*\s*@Service\s*\*/')
-        service_processed_pattern = re.compile(r'/\*--\s*@Service\s*--\*/')
+        service_annotation_pattern = re.compile(r'/\*\s*@(Service|RestController)\s*\*/')
+        service_processed_pattern = re.compile(r'/\*--\s*@(Service|RestController)\s*--\*/')
         
         # Check each line for @Component or @Service annotation or legacy COMPONENT macro
         for line in lines:
@@ -300,7 +303,8 @@ def validate_cpp_file(file_path: str) -> bool:
 def comment_component_macro(file_path: str) -> bool:
     """
     Mark @Component or @Service annotation as processed in a C++ file.
-    Replaces /* @Component */ with /*--@Component--*/ and /* @Service */ with /*--@Service--*/.
+    Replaces /* @Component */ with /*--@Component--*/ and /* @Service */ with /*--@Service--*/
+    (/* @RestController */ likewise becomes /*--@RestController--*/).
     
     Args:
         file_path: Path to the C++ file to modify
@@ -309,13 +313,12 @@ def comment_component_macro(file_path: str) -> bool:
         True if file was modified successfully, False otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
         
         component_annotation_pattern = re.compile(r'/\*\s*@Component\s*\*/')
         component_processed_pattern = re.compile(r'/\*--\s*@Component\s*--\*/')
-        service_annotation_pattern = re.compile(r'/\*\s*@Service\s*\*/')
-        service_processed_pattern = re.compile(r'/\*--\s*@Service\s*--\*/')
+        service_annotation_pattern = re.compile(r'/\*\s*@(Service|RestController)\s*\*/')
+        service_processed_pattern = re.compile(r'/\*--\s*@(Service|RestController)\s*--\*/')
         
         modified = False
         modified_lines = []
@@ -343,7 +346,7 @@ def comment_component_macro(file_path: str) -> bool:
             if service_match:
                 indent = len(line) - len(line.lstrip())
                 indent_str = line[:indent]
-                processed_line = f"{indent_str}/*--@Service--*/\n"
+                processed_line = f"{indent_str}/*--@{service_match.group(1)}--*/\n"
                 modified_lines.append(processed_line)
                 modified = True
                 continue
@@ -358,8 +361,7 @@ def comment_component_macro(file_path: str) -> bool:
         
         # Write back to file if modifications were made
         if modified:
-            with open(file_path, 'w', encoding='utf-8') as file:
-                file.writelines(modified_lines)
+            write_file_atomic(file_path, ''.join(modified_lines))
             # print(f"✓ Processed @Component annotation in: {file_path}")
         else:
             # print(f"ℹ No @Component annotation found to process in: {file_path}")
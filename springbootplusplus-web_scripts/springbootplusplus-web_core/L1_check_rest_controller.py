@@ -9,8 +9,10 @@ import re
 import argparse
 from pathlib import Path
 from typing import List, Dict, Optional, Tuple, Set
+import source_index
 
 
+@source_index.cached_query
 def find_rest_controller_macros(file_path: str) -> List[Dict[str, str]]:
     """
     Find all @RestController annotations in a C++ file and their context.
@@ -25,8 +27,7 @@ def find_rest_controller_macros(file_path: str) -> List[Dict[str, str]]:
     rest_controller_macros = []
     
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return []
@@ -50,12 +51,11 @@ def find_rest_controller_macros(file_path: str) -> List[Dict[str, str]]:
     for line_num, line in enumerate(lines, 1):
         stripped_line = line.strip()
         
-        # Skip already processed annotations
-        if rest_controller_processed_pattern.search(stripped_line):
-            continue
-        
         # Check for @RestController annotation first
-        rest_controller_match = rest_controller_annotation_pattern.search(stripped_line)
+        # A processed /*--@RestController--*/ is still a controller: only the DI stage marks it
+        # (rewriting sources in place turns it into /* @Component */ before that)
+        rest_controller_match = (rest_controller_annotation_pattern.search(stripped_line) or
+                                 rest_controller_processed_pattern.search(stripped_line))
         is_annotation = rest_controller_match is not None
         
         # If not annotation, check for legacy RestController macro
@@ -8,8 +8,10 @@ import re
 import argparse
 from pathlib import Path
 from typing import List, Dict, Optional, Tuple
+import source_index
 import find_class_names
 import find_interface_names
+from codegen_parallel import write_file_atomic
 
 
 def find_interface_header_include(file_path: str, interface_name: str) -> List[Tuple[int, str]]:
@@ -26,8 +28,7 @@ def find_interface_header_include(file_path: str, interface_name: str) -> List[T
     include_lines = []
     
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return []
@@ -91,15 +92,13 @@ def comment_interface_header_includes(file_path: str, dry_run: bool = False) ->
                     else:
                         # Actually comment out the line
                         try:
-                            with open(file_path, 'r', encoding='utf-8') as file:
-                                lines = file.readlines()
+                            lines = source_index.load(file_path).lines
                             
                             # Add comment prefix
                             lines[line_num - 1] = f"// {line_content}\n"
                             
                             # Write back to file
-                            with open(file_path, 'w', encoding='utf-8') as file:
-                                file.writelines(lines)
+                            write_file_atomic(file_path, ''.join(lines))
                             
                             results['commented_includes'].append(f"Commented line {line_num}: {line_content}")
                             
@@ -13,25 +13,26 @@ from typing import List, Optional, Tuple
 # Import functions from our other scripts
 try:
     from find_cpp_files import find_cpp_files
+    import source_index
 except ImportError:
     # print("Error: Could not import required modules. Make sure find_cpp_files.py is in the same directory.")
     sys.exit(1)
 
 
-def find_class_header_file(class_name: str, search_root: str = ".", include_folders: Optional[List[str]] = None, exclude_folders: Optional[List[str]] = None) -> Optional[str]:
+@source_index.cached_listing
+def find_resolved_cpp_files(search_root: str = ".", include_folders: Optional[List[str]] = None, exclude_folders: Optional[List[str]] = None) -> List[str]:
     """
-    Find the header file for a given class/interface name.
+    All C++ source files under the search root, as unique absolute paths.
+    The tree is walked once per process, however many classes are looked up.
     
     Args:
-        class_name: Name of the class/interface to search for
         search_root: Root directory to search for class headers
         include_folders: List of folders to include in search (if None, search all)
         exclude_folders: List of folders to exclude from search
         
     Returns:
-        Path to the class header file, or None if not found
+        List of resolved file paths
     """
-    # Step 1: Get all C++ source files in the search directory with include/exclude options
     all_files_raw = find_cpp_files(
         root_dir=search_root,
         include_folders=include_folders,
@@ -46,6 +47,24 @@ def find_class_header_file(class_name: str, search_root: str = ".", include_fold
         if resolved not in seen_files:
             seen_files.add(resolved)
             all_files.append(resolved)
+    return all_files
+
+
+def find_class_header_file(class_name: str, search_root: str = ".", include_folders: Optional[List[str]] = None, exclude_folders: Optional[List[str]] = None) -> Optional[str]:
+    """
+    Find the header file for a given class/interface name.
+    
+    Args:
+        class_name: Name of the class/interface to search for
+        search_root: Root directory to search for class headers
+        include_folders: List of folders to include in search (if None, search all)
+        exclude_folders: List of folders to exclude from search
+        
+    Returns:
+        Path to the class header file, or None if not found
+    """
+    # Step 1: Get all C++ source files in the search directory with include/exclude options
+    all_files = find_resolved_cpp_files(search_root, include_folders, exclude_folders)
     
     # Step 2: Find files that end with <class-name>.h or <class-name>.hpp (case insensitive)
     potential_headers = []
@@ -72,8 +91,7 @@ def find_class_header_file(class_name: str, search_root: str = ".", include_fold
     
     for header_file in potential_headers:
         try:
-            with open(header_file, 'r', encoding='utf-8') as f:
-                content = f.read()
+            content = source_index.load(header_file).content
                 
             # Enhanced pattern to find class declarations including templates, final, etc.
             import re
@@ -285,6 +303,7 @@ def find_interface_header_file(source_file: str, search_root: str = ".", include
 
 # Export functions for other scripts to import
 __all__ = [
+    'find_resolved_cpp_files',
     'find_class_header_file',
     'find_class_headers_for_names', 
     'get_class_header_for_name',
@@ -9,8 +9,10 @@ import re
 import argparse
 from pathlib import Path
 from typing import Optional, Dict, Any
+import source_index
 
 
+@source_index.cached_query
 def find_request_mapping_macro(file_path: str) -> Optional[Dict[str, Any]]:
     """
     Find @RequestMapping annotation above class declarations in a C++ file.
@@ -22,8 +24,7 @@ def find_request_mapping_macro(file_path: str) -> Optional[Dict[str, Any]]:
         Dictionary with 'url', 'line_number', 'class_name' if found, None otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return None
@@ -5,6 +5,7 @@ Combines @Scope annotation detection and validator logic to determine final scop
 """
 
 import os
+import re
 import sys
 import argparse
 from pathlib import Path
@@ -14,6 +15,7 @@ from typing import Optional, Tuple, Dict, Any
 try:
     from check_scope_macro import find_scope_macros, check_scope_macro_exists
     from L1_get_validator_name import get_validator_name, get_validator_info
+    import source_index
 except ImportError:
     # print("Error: Could not import required modules. Make sure check_scope_macro.py and L1_get_validator_name.py are in the same directory.")
     sys.exit(1)
@@ -27,7 +29,8 @@ def get_file_scope(file_path: str) -> str:
         file_path: Path to the C++ file (.cpp, .h, or .hpp)
         
     Returns:
-        Final scope string: SINGLETON, PROTOTYPE, SINGLETON_VALIDATOR, or PROTOTYPE_VALIDATOR
+        Final scope string: SINGLETON, PROTOTYPE, REQUEST or POOLED, with a _VALIDATOR
+        suffix when the class has a validator (e.g. SINGLETON_VALIDATOR)
     """
     # Step 1: Check for @Scope annotation
     scope_macros = find_scope_macros(file_path)
@@ -62,6 +65,35 @@ def get_file_scope(file_path: str) -> str:
         return final_scope
 
 
+def get_base_scope(file_path: str) -> str:
+    """
+    Determine the base scope (SINGLETON, PROTOTYPE, REQUEST or POOLED) of a C++ file, ignoring validators.
+    Unlike get_file_scope(), this also recognizes @Scope annotations that the DI
+    preprocessor has already marked as processed (/*--@Scope("...")--*/), so it gives
+    the same answer before and after DI processing.
+    
+    Args:
+        file_path: Path to the C++ file (.cpp, .h, or .hpp)
+        
+    Returns:
+        Base scope string: SINGLETON, PROTOTYPE, REQUEST or POOLED
+    """
+    scope_macros = find_scope_macros(file_path)
+    if scope_macros:
+        return scope_macros[0]['scope_value']
+    
+    source = source_index.get_source(file_path)
+    if source is None:
+        return "SINGLETON"
+    
+    for annotation in source.annotations_named('Scope', processed=True):
+        processed_match = re.fullmatch(r'\s*["\'](PROTOTYPE|SINGLETON|REQUEST|POOLED)["\']\s*', annotation.arguments or '')
+        if processed_match:
+            return processed_match.group(1)
+    
+    return "SINGLETON"  # Default scope
+
+
 def get_file_scope_info(file_path: str) -> Dict[str, Any]:
     """
     Get comprehensive scope information for a C++ file.
@@ -277,6 +309,7 @@ def main():
 # Export functions for other scripts to import
 __all__ = [
     'get_file_scope',
+    'get_base_scope',
     'get_file_scope_info',
     'process_multiple_files',
     'main'
@@ -16,6 +16,8 @@ try:
     from L1_get_validator_name import get_validator_name, get_validator_info
     from find_interface_names import find_interface_names
     from find_cpp_files import find_cpp_files
+    from codegen_parallel import write_file_atomic
+    import source_index
 except ImportError:
     # print("Error: Could not import required modules. Make sure L1_get_validator_name.py, find_interface_names.py, and find_cpp_files.py are in the same directory.")
     sys.exit(1)
@@ -120,8 +122,7 @@ def process_file_with_validator_include(file_path: str, search_root: str = ".",
     
     # Step 3: Read the file and process VALIDATE macros
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except Exception as e:
         # print(f"Error reading file '{file_path}': {e}")
         return {
@@ -174,8 +175,7 @@ def process_file_with_validator_include(file_path: str, search_root: str = ".",
     # Step 5: Write the modified file (if not dry run)
     if not dry_run and changes_made:
         try:
-            with open(file_path, 'w', encoding='utf-8') as file:
-                file.writelines(modified_lines)
+            write_file_atomic(file_path, ''.join(modified_lines))
             # print(f"Modified file: {file_path}")
         except Exception as e:
             # print(f"Error writing file '{file_path}': {e}")
@@ -2,15 +2,19 @@
 """
 Script to add implementation template code to C++ header files.
 Inserts template specializations for Implementation<InterfaceName> and Implementation<InterfaceName*> 
-just before the last #endif.
+just before the last #endif. Implementation<InterfaceName>::singleton tells C++ code (Router.h)
+whether GetInstance() returns one shared instance.
 """
 
 import re
 import argparse
 from pathlib import Path
 from typing import List, Dict, Optional, Tuple
+import source_index
 import find_class_names
 import find_interface_names
+from L2_get_file_scope import get_base_scope
+from codegen_parallel import write_file_atomic
 
 
 def find_last_endif(file_path: str) -> Optional[Tuple[int, str]]:
@@ -24,8 +28,7 @@ def find_last_endif(file_path: str) -> Optional[Tuple[int, str]]:
         Tuple of (line_number, line_content) or None if not found
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return None
@@ -43,20 +46,23 @@ def find_last_endif(file_path: str) -> Optional[Tuple[int, str]]:
     return last_endif_line
 
 
-def generate_implementation_template_code(interface_name: str, class_name: str) -> str:
+def generate_implementation_template_code(interface_name: str, class_name: str, scope: str = "SINGLETON") -> str:
     """
     Generate the implementation template code.
     
     Args:
         interface_name: Name of the interface
         class_name: Name of the class
+        scope: Base scope of the class (SINGLETON, PROTOTYPE, REQUEST or POOLED)
         
     Returns:
         Generated template code string to inject
     """
+    singleton = "true" if scope == "SINGLETON" else "false"
     return f"""template <>
 struct Implementation<{interface_name}> {{
     using type = {class_name};
+    static constexpr bool singleton = {singleton};
 }};
 
 template <>
@@ -117,7 +123,7 @@ def inject_implementation_template(file_path: str, dry_run: bool = False) -> Dic
         # print(f"Last #endif found at line {line_num}")
         
         # Step 4: Generate the implementation template code
-        template_code = generate_implementation_template_code(interface_name, class_name)
+        template_code = generate_implementation_template_code(interface_name, class_name, get_base_scope(file_path))
         results['injected_code'] = template_code
         # print(f"Generated implementation template code")
         
@@ -131,15 +137,13 @@ def inject_implementation_template(file_path: str, dry_run: bool = False) -> Dic
         else:
             # Actually inject the code
             try:
-                with open(file_path, 'r', encoding='utf-8') as file:
-                    lines = file.readlines()
+                lines = source_index.load(file_path).lines
                 
                 # Insert the template code before the #endif line
                 lines.insert(line_num - 1, template_code)
                 
                 # Write back to file
-                with open(file_path, 'w', encoding='utf-8') as file:
-                    file.writelines(lines)
+                write_file_atomic(file_path, ''.join(lines))
                 
                 # print(f"Successfully injected implementation template code before line {line_num}")
                 results['success'] = True
@@ -8,10 +8,12 @@ import re
 import argparse
 from pathlib import Path
 from typing import List, Dict, Optional, Tuple
+import source_index
 import L2_get_file_scope
 import find_class_names
 import find_interface_names
 import L1_get_validator_name
+from codegen_parallel import write_file_atomic
 
 
 def find_class_closing_brace(file_path: str) -> Optional[Tuple[int, str]]:
@@ -26,8 +28,7 @@ def find_class_closing_brace(file_path: str) -> Optional[Tuple[int, str]]:
         Tuple of (line_number, line_content) or None if not found
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return None
@@ -81,7 +82,8 @@ def generate_instance_code(scope: str, class_name: str, interface_name: str, val
     Generate the appropriate instance code based on scope.
     
     Args:
-        scope: The file scope (SINGLETON, PROTOTYPE, SINGLETON_VALIDATOR, PROTOTYPE_VALIDATOR)
+        scope: The file scope (SINGLETON, PROTOTYPE, REQUEST, POOLED, or one of them with a
+               _VALIDATOR suffix)
         class_name: Name of the class
         interface_name: Name of the interface
         validator_name: Name of the validator (if applicable)
@@ -123,10 +125,64 @@ def generate_instance_code(scope: str, class_name: str, interface_name: str, val
             return instance;
         }}"""
     
+    elif scope == "REQUEST":
+        return f"""        public: static {interface_ptr_type} GetInstance() {{
+            return RequestScope::GetInstance<{class_name}, {interface_name}>([](void* storage) -> {class_name}* {{ return new (storage) {class_name}(); }});
+        }}"""
+    
+    elif scope == "REQUEST_VALIDATOR":
+        if not validator_name:
+            raise ValueError("Validator name required for REQUEST_VALIDATOR scope")
+        return f"""        public: friend class {validator_name}<{class_name}>;
+        public: static {interface_ptr_type} GetInstance() {{
+            return RequestScope::GetInstance<{validator_name}<{class_name}>, {interface_name}>([](void* storage) -> {validator_name}<{class_name}>* {{ return new (storage) {validator_name}<{class_name}>(); }});
+        }}"""
+    
+    elif scope == "POOLED":
+        return f"""        public: static {interface_ptr_type} GetInstance() {{
+            return BeanPool<{class_name}, {interface_name}>::Instance().Acquire([]() -> {class_name}* {{ return new {class_name}(); }});
+        }}"""
+    
+    elif scope == "POOLED_VALIDATOR":
+        if not validator_name:
+            raise ValueError("Validator name required for POOLED_VALIDATOR scope")
+        return f"""        public: friend class {validator_name}<{class_name}>;
+        public: static {interface_ptr_type} GetInstance() {{
+            return BeanPool<{validator_name}<{class_name}>, {interface_name}>::Instance().Acquire([]() -> {validator_name}<{class_name}>* {{ return new {validator_name}<{class_name}>(); }});
+        }}"""
+    
     else:
         raise ValueError(f"Unknown scope: {scope}")
 
 
+def add_bean_scopes_include(lines: List[str]) -> bool:
+    """
+    Add #include <BeanScopes.h> to a file whose GetInstance() needs the REQUEST / POOLED
+    scope runtime. The include goes before the first #include (or after the include guard).
+    
+    Args:
+        lines: File lines, modified in place
+        
+    Returns:
+        True if the include was added, False if it was already present
+    """
+    include_line = "#include <BeanScopes.h>\n"
+    if any(re.match(r'\s*#include\s*[<"]BeanScopes\.h[>"]', line) for line in lines):
+        return False
+    
+    insert_at = 0
+    for index, line in enumerate(lines):
+        stripped_line = line.strip()
+        if stripped_line.startswith('#include'):
+            insert_at = index
+            break
+        if stripped_line.startswith('#define') or stripped_line.startswith('#pragma once'):
+            insert_at = index + 1
+    
+    lines.insert(insert_at, include_line)
+    return True
+
+
 def inject_instance_code(file_path: str, dry_run: bool = False) -> Dict[str, any]:
     """
     Inject instance code into a C++ file based on its scope and class information.
@@ -210,8 +266,7 @@ def inject_instance_code(file_path: str, dry_run: bool = False) -> Dict[str, any
         else:
             # Actually inject the code
             try:
-                with open(file_path, 'r', encoding='utf-8') as file:
-                    lines = file.readlines()
+                lines = source_index.load(file_path).lines
                 
                 # Insert the instance code before the closing brace
                 # Add proper indentation to match the class structure
@@ -221,9 +276,12 @@ def inject_instance_code(file_path: str, dry_run: bool = False) -> Dict[str, any
                 # Insert the code before the closing brace line
                 lines.insert(line_num - 1, f"{indented_code}\n")
                 
+                # REQUEST / POOLED instances are managed by the BeanScopes.h runtime
+                if scope.split('_')[0] in ('REQUEST', 'POOLED'):
+                    add_bean_scopes_include(lines)
+                
                 # Write back to file
-                with open(file_path, 'w', encoding='utf-8') as file:
-                    file.writelines(lines)
+                write_file_atomic(file_path, ''.join(lines))
                 
                 # print(f"Successfully injected instance code before line {line_num}")
                 results['success'] = True
@@ -344,6 +402,7 @@ def main():
 __all__ = [
     'find_class_closing_brace',
     'generate_instance_code',
+    'add_bean_scopes_include',
     'inject_instance_code',
     'inject_instance_code_in_files',
     'main'
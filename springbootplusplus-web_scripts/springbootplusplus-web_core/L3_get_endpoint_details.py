@@ -9,8 +9,10 @@ import re
 import argparse
 from pathlib import Path
 from typing import List, Dict, Optional, Tuple, Any
+import source_index
 
 
+@source_index.cached_query
 def find_class_and_interface(file_path: str) -> Optional[Dict[str, str]]:
     """
     Find class name and interface name from class declaration.
@@ -23,8 +25,7 @@ def find_class_and_interface(file_path: str) -> Optional[Dict[str, str]]:
         Dictionary with 'class_name' and 'interface_name', or None if not found
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return None
@@ -57,6 +58,7 @@ def find_class_and_interface(file_path: str) -> Optional[Dict[str, str]]:
     return None
 
 
+@source_index.cached_query
 def find_class_boundaries(file_path: str) -> Optional[Tuple[int, int]]:
     """
     Find the start and end line numbers of the class definition.
@@ -68,8 +70,7 @@ def find_class_boundaries(file_path: str) -> Optional[Tuple[int, int]]:
         Tuple of (start_line, end_line) or None if not found
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except Exception as e:
         # print(f"Error reading file '{file_path}': {e}")
         return None
@@ -163,6 +164,7 @@ def parse_function_signature_advanced(line: str) -> Optional[Dict[str, Any]]:
     - /* @RequestBody */ SomeInputDto inputDto
     - /* @PathVariable("xyz") */ StdString someXyz
     - /* @PathVariable("abc") */ const int abc
+    - /* @RequestHeader("X-Device-Id") */ StdString deviceId
     
     Args:
         line: Function signature line (e.g., "Void SomeFun(/* @RequestBody */ SomeInputDto inputDto, /* @PathVariable("xyz") */ StdString someXyz)")
@@ -171,8 +173,8 @@ def parse_function_signature_advanced(line: str) -> Optional[Dict[str, Any]]:
         Dictionary with 'return_type', 'function_name', and 'parameters' (list of parameter dicts),
         or None if parsing fails.
         Each parameter dict contains:
-        - 'type': "RequestBody" or "PathVariable"
-        - 'subType': Path variable name (e.g., "xyz") or empty string for RequestBody
+        - 'type': "RequestBody", "PathVariable" or "RequestHeader"
+        - 'subType': Path variable or header name (e.g., "xyz", "X-Device-Id") or empty string for RequestBody
         - 'class_name': Parameter type (e.g., "SomeInputDto", "StdString", "const int")
         - 'param_name': Parameter name (e.g., "inputDto", "someXyz")
     """
@@ -311,8 +313,8 @@ def _parse_single_parameter(param_str: str) -> Optional[Dict[str, str]]:
     Returns:
         Dictionary with 'type', 'subType', 'class_name', 'param_name', or None if parsing fails
     """
-    # Pattern to match annotation: /* @RequestBody */ or /* @PathVariable("xyz") */
-    annotation_pattern = re.compile(r'/\*\s*@(RequestBody|PathVariable)\s*(?:\(\s*["\']([^"\']+)["\']\s*\))?\s*\*/')
+    # Pattern to match annotation: /* @RequestBody */, /* @PathVariable("xyz") */ or /* @RequestHeader("X-Device-Id") */
+    annotation_pattern = re.compile(r'/\*\s*@(RequestBody|PathVariable|RequestHeader)\s*(?:\(\s*["\']([^"\']+)["\']\s*\))?\s*\*/')
     
     # Find annotation
     annotation_match = annotation_pattern.search(param_str)
@@ -321,9 +323,9 @@ def _parse_single_parameter(param_str: str) -> Optional[Dict[str, str]]:
     sub_type = ""
     
     if annotation_match:
-        param_type = annotation_match.group(1)  # "RequestBody" or "PathVariable"
+        param_type = annotation_match.group(1)  # "RequestBody", "PathVariable" or "RequestHeader"
         if annotation_match.group(2):
-            sub_type = annotation_match.group(2)  # Path variable name (e.g., "xyz")
+            sub_type = annotation_match.group(2)  # Path variable or header name (e.g., "xyz")
         
         # Remove annotation from param_str
         param_str = annotation_pattern.sub('', param_str).strip()
@@ -409,6 +411,10 @@ def _parse_single_parameter(param_str: str) -> Optional[Dict[str, str]]:
         else:
             param_name = "param"
     
+    # /* @RequestHeader */ without a name binds the header named like the parameter
+    if param_type == "RequestHeader" and not sub_type:
+        sub_type = param_name
+    
     return {
         'type': param_type,
         'subType': sub_type,
@@ -417,6 +423,65 @@ def _parse_single_parameter(param_str: str) -> Optional[Dict[str, str]]:
     }
 
 
+# Pattern to match the per-route body size limit annotation: /* @MaxBodySize(64KB) */
+# Units: B (default), KB, MB (powers of 1024); the value may be quoted
+max_body_size_annotation_pattern = re.compile(
+    r'/\*\s*@MaxBodySize\s*\(\s*["\']?\s*(\d+)\s*(B|KB|K|MB|M)?\s*["\']?\s*\)\s*\*/', re.IGNORECASE)
+
+
+def parse_max_body_size(text: str) -> Optional[int]:
+    """
+    Parse a /* @MaxBodySize(...) */ annotation into a size in bytes.
+    
+    Args:
+        text: Line of source code that may contain the annotation
+        
+    Returns:
+        Size in bytes, or None if the annotation is not present
+    """
+    match = max_body_size_annotation_pattern.search(text)
+    if not match:
+        return None
+    
+    value = int(match.group(1))
+    unit = (match.group(2) or 'B').upper()
+    multipliers = {'B': 1, 'K': 1024, 'KB': 1024, 'M': 1024 * 1024, 'MB': 1024 * 1024}
+    return value * multipliers[unit]
+
+
+def find_max_body_size(lines: List[str], mapping_line: int, function_line: Optional[int]) -> Optional[int]:
+    """
+    Find a /* @MaxBodySize(...) */ annotation belonging to an endpoint.
+    The annotation may sit in the comment block directly above the mapping annotation,
+    on the mapping line itself, or between the mapping annotation and the function.
+    
+    Args:
+        lines: File lines
+        mapping_line: 1-indexed line of the mapping annotation
+        function_line: 1-indexed first line of the function signature (or None)
+        
+    Returns:
+        Size in bytes, or None if the endpoint has no limit annotation
+    """
+    # Mapping line and lines up to the function signature
+    last_line = function_line if function_line else mapping_line
+    for line_number in range(mapping_line, last_line + 1):
+        size = parse_max_body_size(lines[line_number - 1])
+        if size is not None:
+            return size
+    
+    # Contiguous annotation comments directly above the mapping
+    line_number = mapping_line - 1
+    while line_number >= 1 and lines[line_number - 1].strip().startswith('/*'):
+        size = parse_max_body_size(lines[line_number - 1])
+        if size is not None:
+            return size
+        line_number -= 1
+    
+    return None
+
+
+@source_index.cached_query
 def find_mapping_endpoints(file_path: str, base_url: str, class_name: str, interface_name: str) -> List[Dict[str, Any]]:
     """
     Find all HTTP mapping endpoints (GetMapping, PostMapping, PutMapping, DeleteMapping, PatchMapping) 
@@ -432,8 +497,7 @@ def find_mapping_endpoints(file_path: str, base_url: str, class_name: str, inter
         List of dictionaries with endpoint details
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except Exception as e:
         return []
     
@@ -627,7 +691,8 @@ def find_mapping_endpoints(file_path: str, base_url: str, class_name: str, inter
                     'class_name': class_name,
                     'interface_name': interface_name,
                     'mapping_line': i,
-                    'function_line': function_start_line if function_start_line else None
+                    'function_line': function_start_line if function_start_line else None,
+                    'max_body_size': find_max_body_size(lines, i, function_start_line)
                 }
                 endpoints.append(endpoint_info)
         
@@ -774,7 +839,9 @@ def format_endpoint_with_advanced_signature(endpoint: Dict[str, Any]) -> Dict[st
             'endpoint_type': str,              # "POST", "PUT", "GET", "DELETE", "PATCH"
             'return_type': str,                # e.g., "Void", "MyReturnDto", "int"
             'function_name': str,              # e.g., "SomeFun", "CreateUser"
-            'parameters': List[Dict]           # List of parameter dictionaries (maintains order)
+            'parameters': List[Dict],          # List of parameter dictionaries (maintains order)
+            'max_body_size': Optional[int],    # Per-route body limit in bytes from /* @MaxBodySize(...) */
+            'controller_scope': str            # "SINGLETON", "PROTOTYPE", "REQUEST" or "POOLED" (defaults to SINGLETON)
         }
     """
     # Extract or use existing parameters list
@@ -792,7 +859,9 @@ def format_endpoint_with_advanced_signature(endpoint: Dict[str, Any]) -> Dict[st
         'endpoint_type': endpoint.get('http_method', ''),  # Already in uppercase (GET, POST, etc.)
         'return_type': endpoint.get('return_type', ''),
         'function_name': endpoint.get('function_name', ''),
-        'parameters': parameters
+        'parameters': parameters,
+        'max_body_size': endpoint.get('max_body_size'),
+        'controller_scope': endpoint.get('controller_scope', 'SINGLETON')
     }
 
 
@@ -842,6 +911,8 @@ __all__ = [
     'parse_function_signature',
     'parse_function_signature_advanced',
     '_parse_single_parameter',
+    'parse_max_body_size',
+    'find_max_body_size',
     'find_mapping_endpoints',
     'get_endpoint_details',
     'format_endpoint_with_advanced_signature',
@@ -155,8 +155,9 @@ def generate_function_pointer_advanced(formatted_endpoint: Dict[str, Any]) -> st
     Generate function pointer code for an HTTP mapping endpoint using advanced parameter parsing.
     
     This function generates code that handles:
-    - RequestBody parameters (deserialized from payload)
-    - PathVariable parameters (extracted from variables map using ConvertToType)
+    - RequestBody parameters (deserialized from the request body)
+    - PathVariable parameters (extracted from the request's path variables using ConvertToType)
+    - RequestHeader parameters (looked up in the request's header index using ConvertHeader)
     - Void and non-void return types
     
     Args:
@@ -167,7 +168,9 @@ def generate_function_pointer_advanced(formatted_endpoint: Dict[str, Any]) -> st
                 'endpoint_type': str,              # "POST", "PUT", "GET", "DELETE", "PATCH"
                 'return_type': str,                # e.g., "Void", "MyReturnDto", "int"
                 'function_name': str,              # e.g., "SomeFun", "CreateUser"
-                'parameters': List[Dict]           # List of parameter dictionaries
+                'parameters': List[Dict],          # List of parameter dictionaries
+                'max_body_size': Optional[int],    # Per-route body limit in bytes (optional)
+                'controller_scope': str            # "SINGLETON" (default), "PROTOTYPE", "REQUEST" or "POOLED"
             }
     
     Returns:
@@ -180,6 +183,8 @@ def generate_function_pointer_advanced(formatted_endpoint: Dict[str, Any]) -> st
     return_type = formatted_endpoint.get('return_type', '')
     function_name = formatted_endpoint.get('function_name', '')
     parameters = formatted_endpoint.get('parameters', [])
+    max_body_size = formatted_endpoint.get('max_body_size')
+    controller_scope = formatted_endpoint.get('controller_scope', 'SINGLETON')
     
     # Get the mapping variable name based on HTTP method
     mapping_var = get_mapping_variable_name(endpoint_type)
@@ -200,6 +205,7 @@ def generate_function_pointer_advanced(formatted_endpoint: Dict[str, Any]) -> st
     # Check which parameters are used
     has_request_body = False
     has_path_variable = False
+    has_request_header = False
     
     for param in parameters:
         param_type = param.get('type', '')
@@ -207,29 +213,37 @@ def generate_function_pointer_advanced(formatted_endpoint: Dict[str, Any]) -> st
             has_request_body = True
         elif param_type == 'PathVariable':
             has_path_variable = True
+        elif param_type == 'RequestHeader':
+            has_request_header = True
         else:
             # Fallback: treat as RequestBody
             has_request_body = True
     
     # Generate lambda signature with commented unused parameters
     # Return type is now IHttpResponsePtr instead of StdString
-    if has_request_body and has_path_variable:
-        # Both are used
-        lambda_signature = "[](CStdString payload, Map<StdString, StdString> variables) -> IHttpResponsePtr"
-    elif has_request_body and not has_path_variable:
-        # Only payload is used
-        lambda_signature = "[](CStdString payload, Map<StdString, StdString> /*variables*/) -> IHttpResponsePtr"
-    elif not has_request_body and has_path_variable:
-        # Only variables is used
-        lambda_signature = "[](CStdString /*payload*/, Map<StdString, StdString> variables) -> IHttpResponsePtr"
-    else:
-        # Neither is used (no parameters)
-        lambda_signature = "[](CStdString /*payload*/, Map<StdString, StdString> /*variables*/) -> IHttpResponsePtr"
+    # The request view carries the body and path variables; the ContentFormat
+    # (HEAD without body) is only needed when there is a body to send
+    request_param = "const HttpRequestView& request" if (has_request_body or has_path_variable or has_request_header) else "const HttpRequestView& /*request*/"
+    format_param = "const ContentFormat& /*format*/" if is_void else "const ContentFormat& format"
+    # The lambda never captures, so it converts to a plain HttpRequestHandler function
+    # pointer. SINGLETON controllers are resolved into SingletonBeanSlot by their
+    # BeanStartup entry and read without an initialization guard; other scopes
+    # resolve an instance per request (PROTOTYPE: new, REQUEST: request scope, POOLED: bean pool)
+    # Devirtualize() types the reference as the implementation class when it is final,
+    # so the controller method is called directly instead of through the interface
+    is_singleton = controller_scope == 'SINGLETON'
+    call_prefix = "controller."
+    lambda_signature = f"[]({request_param}, {format_param}) -> IHttpResponsePtr"
     
     # Generate the function pointer code
     code = f"{mapping_var}[\"{complete_url}\"] = {lambda_signature} {{\n"
-    code += "//                 AUTOWIRED\n"
-    code += f"    {controller_interface}Ptr controller = Implementation<{controller_interface}>::type::GetInstance();\n"
+    if is_singleton:
+        code += "//                 AUTOWIRED (SINGLETON, resolved at startup)\n"
+        code += f"    auto& controller = SingletonBeanSlot<{controller_interface}>::Get();\n"
+    else:
+        code += f"//                 AUTOWIRED ({controller_scope}, resolved per request)\n"
+        code += f"    {controller_interface}Ptr bean = Implementation<{controller_interface}>::type::GetInstance();\n"
+        code += "    auto& controller = HttpRequestDispatcher::Devirtualize(*bean);\n"
     
     # Build function call arguments
     function_args = []
@@ -237,13 +251,13 @@ def generate_function_pointer_advanced(formatted_endpoint: Dict[str, Any]) -> st
     for param in parameters:
         param_type = param.get('type', '')
         param_class_name = param.get('class_name', '')
-        param_sub_type = param.get('subType', '')  # Path variable name for PathVariable
+        param_sub_type = param.get('subType', '')  # Path variable / header name
         
         if param_type == 'RequestBody':
-            # Deserialize from payload
-            function_args.append(f"nayan::serializer::SerializationUtility::Deserialize<{param_class_name}>(payload)")
+            # Deserialize from the request body
+            function_args.append(f"HttpRequestDispatcher::DeserializeBody<{param_class_name}>(request.GetBody())")
         elif param_type == 'PathVariable':
-            # Extract from variables map and convert to type
+            # Extract from the request path variables and convert to type
             # Strip 'const' and other qualifiers for ConvertToType template parameter
             # ConvertToType needs the base type, not const-qualified
             type_for_conversion = param_class_name.strip()
@@ -252,39 +266,51 @@ def generate_function_pointer_advanced(formatted_endpoint: Dict[str, Any]) -> st
                 type_for_conversion = type_for_conversion[6:].strip()
             # Use ConvertToType to convert the string value to the appropriate type
             # Qualify with class name since it's a member function template
-            function_args.append(f"HttpRequestDispatcher::ConvertToType<{type_for_conversion}>(variables[\"{param_sub_type}\"])")
+            function_args.append(f"HttpRequestDispatcher::ConvertToType<{type_for_conversion}>(request.GetPathVariable(\"{param_sub_type}\"))")
+        elif param_type == 'RequestHeader':
+            # Look the header up in the per-request header index and convert it;
+            # std::string_view parameters receive a view into the request headers
+            type_for_conversion = param_class_name.strip()
+            if type_for_conversion.startswith('const '):
+                type_for_conversion = type_for_conversion[6:].strip()
+            type_for_conversion = type_for_conversion.rstrip('&').strip()
+            function_args.append(f"HttpRequestDispatcher::ConvertHeader<{type_for_conversion}>(request, \"{param_sub_type}\")")
         else:
             # Fallback: treat as RequestBody
-            function_args.append(f"nayan::serializer::SerializationUtility::Deserialize<{param_class_name}>(payload)")
+            function_args.append(f"HttpRequestDispatcher::DeserializeBody<{param_class_name}>(request.GetBody())")
     
     # Generate function call
     if is_void:
         # For void return types, call controller method and return CreateOkResponse() (no body)
         if function_args:
             args_str = ", ".join(function_args)
-            code += f"    controller->{function_name}({args_str});\n"
+            code += f"    {call_prefix}{function_name}({args_str});\n"
         else:
-            code += f"    controller->{function_name}();\n"
+            code += f"    {call_prefix}{function_name}();\n"
         code += "    return ResponseEntityConverter::CreateOkResponse();\n"
     elif is_response_entity:
         # For ResponseEntity<T> return types, store return value and use ToHttpResponse<EntityType>(returnValue)
         if function_args:
             args_str = ", ".join(function_args)
-            code += f"    {cleaned_return_type} returnValue = controller->{function_name}({args_str});\n"
+            code += f"    {cleaned_return_type} returnValue = {call_prefix}{function_name}({args_str});\n"
         else:
-            code += f"    {cleaned_return_type} returnValue = controller->{function_name}();\n"
-        code += f"    return ResponseEntityConverter::ToHttpResponse<{entity_type}>(returnValue);\n"
+            code += f"    {cleaned_return_type} returnValue = {call_prefix}{function_name}();\n"
+        code += f"    return ResponseEntityConverter::ToHttpResponse<{entity_type}>(returnValue, format);\n"
     else:
         # For non-void, non-ResponseEntity return types, store return value and use CreateOkResponse<T>(returnValue)
         if function_args:
             args_str = ", ".join(function_args)
-            code += f"    {cleaned_return_type} returnValue = controller->{function_name}({args_str});\n"
+            code += f"    {cleaned_return_type} returnValue = {call_prefix}{function_name}({args_str});\n"
         else:
-            code += f"    {cleaned_return_type} returnValue = controller->{function_name}();\n"
-        code += f"    return ResponseEntityConverter::CreateOkResponse<{cleaned_return_type}>(returnValue);\n"
+            code += f"    {cleaned_return_type} returnValue = {call_prefix}{function_name}();\n"
+        code += f"    return ResponseEntityConverter::CreateOkResponse<{cleaned_return_type}>(returnValue, format);\n"
     
     code += "};"
     
+    # Per-route request body limit from /* @MaxBodySize(...) */
+    if max_body_size is not None:
+        code += f"\nSetMaxBodySize(HttpMethod::{endpoint_type}, \"{complete_url}\", {max_body_size});"
+    
     return code
 
 
@@ -18,6 +18,8 @@ from pathlib import Path
 # Import our utility scripts
 try:
     from find_class_names import get_class_names_from_file
+    from codegen_parallel import write_file_atomic
+    import source_index
 except ImportError:
     # print("Error: Could not import find_class_names.py")
     sys.exit(1)
@@ -33,8 +35,7 @@ def find_autowired_macros(file_path):
     autowired_macros = []
     
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
         
         # Pattern for @Autowired annotation (search for /* @Autowired */ or /*@Autowired*/)
         autowired_annotation_pattern = re.compile(r'/\*\s*@Autowired\s*\*/')
@@ -115,8 +116,7 @@ def find_autowired_constructor(file_path, class_name):
         dict: Constructor info or None if not found
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
         
         # Pattern for @Autowired annotation (search for /* @Autowired */ or /*@Autowired*/)
         autowired_annotation_pattern = re.compile(r'/\*\s*@Autowired\s*\*/')
@@ -523,8 +523,7 @@ def apply_autowired_changes(file_path, macro_info, replacement_code):
         bool: True if successful, False otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
         
         # Comment out the AUTOWIRED macro
         autowired_line = macro_info['line_number'] - 1  # Convert to 0-based index
@@ -535,8 +534,7 @@ def apply_autowired_changes(file_path, macro_info, replacement_code):
         lines[var_line] = f"{replacement_code}\n"
         
         # Write back to file
-        with open(file_path, 'w', encoding='utf-8') as file:
-            file.writelines(lines)
+        write_file_atomic(file_path, ''.join(lines))
             
         return True
         
@@ -616,8 +614,7 @@ def apply_all_autowired_changes(file_path, all_macros):
         bool: True if successful, False otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
         
         # Sort macros by line number in descending order to avoid line number shifting
         sorted_macros = sorted(all_macros, key=lambda x: x['line_number'], reverse=True)
@@ -657,8 +654,7 @@ def apply_all_autowired_changes(file_path, all_macros):
                         lines[start_line + i] = replacement_line
         
         # Write back to file
-        with open(file_path, 'w', encoding='utf-8') as file:
-            file.writelines(lines)
+        write_file_atomic(file_path, ''.join(lines))
             
         return True
         
@@ -12,6 +12,7 @@ import subprocess
 from pathlib import Path
 from typing import List, Dict, Optional, Tuple
 import L1_check_component_macro
+import di_bean_parts
 
 # Get the directory where this script is located
 SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
@@ -60,6 +61,11 @@ def run_script_sequence(file_path: str, include_paths: List[str], exclude_paths:
     try:
         # print(f"\nProcessing component file: {file_path}")
         
+        # Step 0: comment out the generated part (#include "X.beans.h", GeneratedBean(X));
+        # in place the bean code is written into the class instead
+        if di_bean_parts.comment_bean_part_lines(file_path, dry_run):
+            results['steps_completed'].append('comment_bean_part_lines')
+        
         # Step 1: L3_add_instance_code
         # print("\n--- Step 1: Adding instance code ---")
         script_path = os.path.join(SCRIPT_DIR, 'L3_add_instance_code.py')
@@ -22,11 +22,12 @@ sys.path.insert(0, script_dir)
 try:
     import L1_check_rest_controller
     import L2_get_base_url
+    import L2_get_file_scope
     import L3_get_endpoint_details
     import L4_generate_function_pointer
 except ImportError as e:
     # print(f"Error: Could not import required modules: {e}")
-    # print("Make sure L1_check_rest_controller.py, L2_get_base_url.py, L3_get_endpoint_details.py, and L4_generate_function_pointer.py are in the springbootplusplus-web_core directory.")
+    # print("Make sure L1_check_rest_controller.py, L2_get_base_url.py, L2_get_file_scope.py, L3_get_endpoint_details.py, and L4_generate_function_pointer.py are in the springbootplusplus-web_core directory.")
     sys.exit(1)
 
 
@@ -67,11 +68,15 @@ def process_file(file_path: str) -> Optional[List[Dict[str, Any]]]:
     if not endpoint_details['success'] or not endpoint_details['endpoints']:
         return []
     
+    # Step 4: Get controller scope (decides how handlers obtain the controller)
+    controller_scope = L2_get_file_scope.get_base_scope(file_path)
+    
     # Return the endpoints with file path for reference
     endpoints = endpoint_details['endpoints']
     for endpoint in endpoints:
         endpoint['file_path'] = file_path
         endpoint['base_url'] = base_url
+        endpoint['controller_scope'] = controller_scope
     
     return endpoints
 
@@ -129,7 +134,7 @@ def process_all_files(file_paths: List[str]) -> Dict[str, List[Dict[str, Any]]]:
 def generate_code_for_endpoint(endpoint: Dict[str, Any]) -> str:
     """
     Generate function pointer code for a single endpoint.
-    Uses the advanced function signature parsing to handle RequestBody and PathVariable parameters.
+    Uses the advanced function signature parsing to handle RequestBody, PathVariable and RequestHeader parameters.
     
     Args:
         endpoint: Endpoint dictionary with all details (from find_mapping_endpoints or get_endpoint_details)
@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""
+L5 Generate Bean Startup Script
+
+This script:
+1. Finds all components (@Component, @Service or @RestController, processed or not)
+2. Determines each component's interface, class and scope
+3. Builds the dependency graph from @Autowired fields and constructors
+4. Generates BeanStartup registrations for InitializeBeans() in HttpRequestDispatcher.h
+
+Only SINGLETON beans are registered: they are the ones GetInstance() caches, so they
+are the ones worth constructing before the first request. The C++ side (BeanStartup.h)
+orders them by the dependency graph. Each entry resolves the bean into its
+SingletonBeanSlot, which generated handlers read for SINGLETON controllers.
+"""
+
+import argparse
+import os
+import re
+import sys
+from typing import Dict, List, Optional
+
+# Add springbootplusplus-web_core directory to path for imports (current directory)
+script_dir = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, script_dir)
+
+try:
+    import L3_get_endpoint_details
+    import L2_get_file_scope
+    import codegen_cache
+    import codegen_parallel
+    import source_index
+except ImportError as e:
+    # print(f"Error: Could not import required modules: {e}")
+    sys.exit(1)
+
+
+# Component annotations, matched before (/* @X */) and after (/*--@X--*/) processing
+component_annotations = ('Component', 'Service', 'RestController')
+
+# Dependency references on the autowired declaration:
+#   IFooPtr foo;                                              (unprocessed)
+#   IFooPtr foo = Implementation<IFoo>::type::GetInstance();  (processed)
+pointer_type_pattern = re.compile(r'\b([A-Za-z_][A-Za-z0-9_]*)Ptr\b')
+implementation_pattern = re.compile(r'Implementation<\s*([A-Za-z_][A-Za-z0-9_]*)\s*>')
+
+
+def find_autowired_dependencies(source: source_index.SourceFile) -> List[str]:
+    """
+    Find the interface names a component autowires.
+    Looks at the declarations annotated with @Autowired (fields, and constructors up
+    to their opening brace).
+
+    Args:
+        source: Indexed C++ file (source_index.load)
+
+    Returns:
+        Interface names in order of first appearance (may include non-bean types)
+    """
+    dependencies = []
+
+    for declaration in source.declarations:
+        if not declaration.has_annotation('Autowired'):
+            continue
+
+        for name in implementation_pattern.findall(declaration.text) + pointer_type_pattern.findall(declaration.text):
+            if name not in dependencies:
+                dependencies.append(name)
+
+    return dependencies
+
+
+def find_bean_definition(file_path: str) -> Optional[Dict[str, any]]:
+    """
+    Describe the component defined in a file.
+
+    Args:
+        file_path: Path to the C++ file
+
+    Returns:
+        Dictionary with 'file_path', 'class_name', 'interface_name', 'scope' and
+        'dependencies' keys, or None if the file does not define a component
+    """
+    source = source_index.get_source(file_path)
+    if source is None:
+        return None
+
+    if not any(source.has_annotation(name) for name in component_annotations):
+        return None
+
+    class_info = L3_get_endpoint_details.find_class_and_interface(file_path)
+    if not class_info or not class_info.get('interface_name'):
+        return None
+
+    return {
+        'file_path': file_path,
+        'class_name': class_info['class_name'],
+        'interface_name': class_info['interface_name'],
+        'scope': L2_get_file_scope.get_base_scope(file_path),
+        'dependencies': find_autowired_dependencies(source)
+    }
+
+
+def find_bean_definitions(cpp_files: List[str], cache=None, jobs: Optional[int] = None) -> List[Dict[str, any]]:
+    """
+    Describe all components in the given files, sorted by interface name.
+    Dependencies are narrowed down to interfaces implemented by one of the components.
+
+    Args:
+        cpp_files: List of C++ file paths
+        cache: Optional codegen_cache.CodegenCache; unchanged files are not reparsed
+        jobs: Number of worker processes (None for all cores, 1 for serial)
+
+    Returns:
+        List of bean definitions (see find_bean_definition)
+    """
+    definitions = {}
+    content_hashes = {}
+    pending_files = []
+    for file_path in cpp_files:
+        if cache:
+            content_hashes[file_path] = codegen_cache.hash_file(file_path)
+            hit, bean = cache.lookup(file_path, content_hashes[file_path], 'bean')
+            if hit:
+                definitions[file_path] = bean
+                continue
+        pending_files.append(file_path)
+
+    for file_path, bean in zip(pending_files, codegen_parallel.parallel_map(find_bean_definition, pending_files, jobs)):
+        definitions[file_path] = bean
+        if cache:
+            cache.store(file_path, content_hashes[file_path], 'bean', bean)
+
+    beans = [dict(definitions[file_path]) for file_path in cpp_files if definitions.get(file_path)]
+
+    bean_interfaces = {bean['interface_name'] for bean in beans}
+    for bean in beans:
+        bean['dependencies'] = [
+            dependency for dependency in bean['dependencies']
+            if dependency in bean_interfaces and dependency != bean['interface_name']
+        ]
+
+    return sorted(beans, key=lambda bean: bean['interface_name'])
+
+
+def generate_bean_startup_code(beans: List[Dict[str, any]]) -> str:
+    """
+    Generate the body of HttpRequestDispatcher::InitializeBeans().
+
+    Example output:
+        BeanStartup& startup = BeanStartup::Instance();
+        startup.Register("IUserService", {"IUserRepository"}, &ResolveSingletonBean<IUserService>);
+
+    Args:
+        beans: Bean definitions from find_bean_definitions()
+
+    Returns:
+        Generated code, or an empty string if there are no SINGLETON beans
+    """
+    singletons = [bean for bean in beans if bean['scope'] == 'SINGLETON']
+    if not singletons:
+        return ""
+
+    code = "BeanStartup& startup = BeanStartup::Instance();\n"
+    for bean in singletons:
+        interface_name = bean['interface_name']
+        dependencies = ", ".join(f'"{dependency}"' for dependency in bean['dependencies'])
+        code += (f'startup.Register("{interface_name}", {{{dependencies}}}, '
+                 f'&ResolveSingletonBean<{interface_name}>);\n')
+    return code
+
+
+def main():
+    """Main function to handle command line arguments and print the bean graph."""
+    parser = argparse.ArgumentParser(
+        description="Generate eager bean startup registrations from the @Autowired dependency graph"
+    )
+    parser.add_argument(
+        "files",
+        nargs="+",
+        help="C++ source files to analyze (.cpp, .h, .hpp, etc.)"
+    )
+
+    args = parser.parse_args()
+
+    beans = find_bean_definitions(args.files)
+    code = generate_bean_startup_code(beans)
+    # print(code)
+
+    return code
+
+
+# Export functions for other scripts to import
+__all__ = [
+    'find_autowired_dependencies',
+    'find_bean_definition',
+    'find_bean_definitions',
+    'generate_bean_startup_code',
+    'main'
+]
+
+
+if __name__ == "__main__":
+    main()
@@ -5,11 +5,21 @@ L6 CPP DI Preprocessor Script
 This script orchestrates the complete dependency injection preprocessing workflow by:
 1. Finding all C++ source files in the specified include/exclude paths
 2. Running L5_process_di.py on each source file to process COMPONENT and AUTOWIRED macros
+   (files already processed in a previous run and unchanged since are skipped via the codegen cache)
+3. Running independent files in parallel: a component and the header declaring its interface
+   (which DI also rewrites) stay in one group and keep their serial order
+4. Rejecting @Scope("REQUEST") beans injected into SINGLETON or POOLED beans
+   (check_request_scope_injection.py); with --generated-dir each rejection also becomes an
+   #error in the component's generated part, so the build stops at the offending @Autowired line
+
+With --generated-dir the sources are not modified: each component gets a generated header
+with its bean code instead, which the component includes (see di_bean_parts.py).
 
 This is the highest-level script that automates the entire DI preprocessing pipeline.
 """
 
 import argparse
+import functools
 import subprocess
 import sys
 import os
@@ -18,6 +28,14 @@ from typing import List, Dict, Optional
 
 # Get the directory where this script is located
 SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, SCRIPT_DIR)
+
+import codegen_cache
+import codegen_parallel
+import di_bean_parts
+import check_request_scope_injection
+import source_index
+from find_interface_names import find_interface_names
 
 
 def find_cpp_files(include_paths: List[str], exclude_paths: List[str]) -> List[str]:
@@ -144,15 +162,69 @@ def run_l5_process_di(file_path: str, include_paths: List[str], exclude_paths: L
         return error_result
 
 
-def process_all_files(cpp_files: List[str], include_paths: List[str], exclude_paths: List[str], dry_run: bool = False) -> Dict[str, any]:
+def declared_class_names(file_path: str) -> List[str]:
+    """
+    Names of the classes declared in a file (used to find components whose interface changed).
+    
+    Args:
+        file_path: Path to the C++ file
+        
+    Returns:
+        List of class names
+    """
+    source = source_index.get_source(file_path)
+    return list(source.class_names) if source else []
+
+
+def run_l5_process_di_group(file_paths: List[str], include_paths: List[str], exclude_paths: List[str], dry_run: bool = False) -> List[Dict[str, any]]:
+    """
+    Run L5_process_di.py on a group of related files, one after the other.
+    
+    Args:
+        file_paths: Files of one group (see process_all_files)
+        include_paths: List of include paths
+        exclude_paths: List of exclude paths
+        dry_run: Whether to run in dry-run mode
+        
+    Returns:
+        Results of run_l5_process_di, in the order of file_paths
+    """
+    return [run_l5_process_di(file_path, include_paths, exclude_paths, dry_run) for file_path in file_paths]
+
+
+def related_class_names(file_path: str) -> List[str]:
+    """
+    Classes a file declares or implements. DI on a component rewrites the header
+    declaring its interface, so files sharing one of these names are processed in
+    the same group.
+    
+    Args:
+        file_path: Path to the C++ file
+        
+    Returns:
+        List of class names
+    """
+    return declared_class_names(file_path) + find_interface_names(file_path)
+
+
+def process_all_files(cpp_files: List[str], include_paths: List[str], exclude_paths: List[str], dry_run: bool = False, cache: Optional[codegen_cache.CodegenCache] = None, jobs: Optional[int] = None) -> Dict[str, any]:
     """
     Process all C++ files with L5_process_di.py.
     
+    With a cache, a file is skipped if DI already ran on exactly its current content and
+    the file declaring its interface did not change either (DI also edits that header).
+    
+    The remaining files are split into groups of related files (related_class_names);
+    groups run in parallel, files within a group in cpp_files order, so every file
+    sees the same sequence of edits as in a serial run.
+    
     Args:
         cpp_files: List of C++ file paths to process
         include_paths: List of include paths
         exclude_paths: List of exclude paths
         dry_run: Whether to run in dry-run mode
+        cache: Optional codegen cache
+        jobs: Number of parallel groups (None for all cores, 1 for serial)
         
     Returns:
         Dictionary with overall results
@@ -168,10 +240,45 @@ def process_all_files(cpp_files: List[str], include_paths: List[str], exclude_pa
         'errors': []
     }
     
-    for i, file_path in enumerate(cpp_files, 1):
-        # Process the file
-        file_result = run_l5_process_di(file_path, include_paths, exclude_paths, dry_run)
-        results['file_results'][file_path] = file_result
+    hashes = {}
+    cached_di = {}
+    changed_classes = set()
+    if cache:
+        for file_path in cpp_files:
+            hashes[file_path] = codegen_cache.hash_file(file_path)
+            hit, di_info = cache.lookup(file_path, hashes[file_path], 'di')
+            if hit:
+                cached_di[file_path] = di_info
+            else:
+                changed_classes.update(declared_class_names(file_path))
+    
+    # Skip files whose DI processing is still valid
+    pending_files = []
+    for file_path in cpp_files:
+        di_info = cached_di.get(file_path)
+        if di_info is not None and di_info.get('interface_name') not in changed_classes:
+            results['file_results'][file_path] = {'success': True, 'cached': True, 'errors': []}
+            continue
+        pending_files.append(file_path)
+    
+    # Process the groups; each L5_process_di.py run is a subprocess, so threads are enough
+    groups = codegen_parallel.group_related_files(pending_files, related_class_names)
+    group_results = codegen_parallel.parallel_map(
+        functools.partial(run_l5_process_di_group, include_paths=include_paths, exclude_paths=exclude_paths, dry_run=dry_run),
+        groups, jobs, threads=True)
+    for group, file_results in zip(groups, group_results):
+        for file_path, file_result in zip(group, file_results):
+            results['file_results'][file_path] = file_result
+    
+    # Merge in cpp_files order
+    for file_path in cpp_files:
+        file_result = results['file_results'][file_path]
+        
+        if cache and file_result['success'] and not file_result.get('cached'):
+            new_hash = codegen_cache.hash_file(file_path)
+            cache.advance(file_path, hashes.get(file_path), new_hash)
+            interface_names = find_interface_names(file_path)
+            cache.store(file_path, new_hash, 'di', {'interface_name': interface_names[0] if interface_names else None})
         
         # Update counters
         if file_result['success']:
@@ -181,6 +288,11 @@ def process_all_files(cpp_files: List[str], include_paths: List[str], exclude_pa
             if file_result['errors']:
                 results['errors'].extend([f"{file_path}: {error}" for error in file_result['errors']])
     
+    # DI also rewrites headers it did not process directly (reverse includes in interface headers)
+    if cache:
+        for file_path in cpp_files:
+            cache.advance(file_path, hashes.get(file_path), codegen_cache.hash_file(file_path))
+    
     return results
 
 
@@ -269,6 +381,32 @@ Examples:
         help="Show detailed summary of results"
     )
     
+    parser.add_argument(
+        "--jobs",
+        "-j",
+        type=int,
+        default=None,
+        help="Number of files processed in parallel (default: all cores)"
+    )
+    
+    parser.add_argument(
+        "--cache-file",
+        default=codegen_cache.DEFAULT_CACHE_FILE,
+        help=f"Codegen cache keyed by file content hash (default: {codegen_cache.DEFAULT_CACHE_FILE})"
+    )
+    
+    parser.add_argument(
+        "--no-cache",
+        action="store_true",
+        help="Process every file and do not update the cache"
+    )
+    
+    parser.add_argument(
+        "--generated-dir",
+        default=None,
+        help="Leave the sources untouched: write each component's bean code into <file>.beans.h in this directory"
+    )
+    
     args = parser.parse_args()
     
     # Show configuration
@@ -285,8 +423,39 @@ Examples:
     if not cpp_files:
         sys.exit(0)
     
-    # Process all files
-    results = process_all_files(cpp_files, args.include, args.exclude, args.dry_run)
+    # REQUEST beans must not be injected into beans that outlive the request
+    violations = check_request_scope_injection.find_request_scope_violations(cpp_files)
+    rejected = []
+    for violation in violations:
+        message = check_request_scope_injection.format_violation(violation)
+        print(f"{violation['file_path']}:{violation['line_number']}: error: {message}", file=sys.stderr)
+        rejected.append((violation['file_path'], violation['line_number'], message))
+    
+    # Results of unchanged files come from the cache
+    cache = None
+    if not args.no_cache and not args.dry_run:
+        cache = codegen_cache.CodegenCache(args.cache_file)
+    
+    if args.generated_dir and not args.dry_run:
+        # Sources stay untouched: each component gets its generated part instead
+        _, part_errors = di_bean_parts.write_bean_parts(cpp_files, args.include, args.exclude, args.generated_dir, rejected)
+        results = {'total_files': len(cpp_files), 'successful_files': len(cpp_files), 'failed_files': 0,
+                   'file_results': {}, 'errors': []}
+        for error in part_errors:
+            print(error, file=sys.stderr)
+            results['errors'].append(error)
+            results['failed_files'] += 1
+            results['successful_files'] -= 1
+    else:
+        # Process all files
+        results = process_all_files(cpp_files, args.include, args.exclude, args.dry_run, cache=cache, jobs=args.jobs)
+    
+    if cache:
+        cache.save()
+    
+    for file_path, line_number, message in rejected:
+        results['errors'].append(f"{file_path}:{line_number}: {message}")
+        results['failed_files'] += 1
     
     # Display summary
     display_summary(results, args.dry_run)
@@ -5,13 +5,23 @@ L6 Generate Code for All Sources Script
 This script:
 1. Finds all C++ source files (using logic from L6_cpp_di_preprocessor.py)
 2. Generates endpoint code for each file using L5_generate_code_for_file.py
+   (in parallel over all cores, merged in file order; see codegen_parallel.py)
 3. Marks REST-related annotations as processed (/* @RestController */, /* @RequestMapping("...") */, etc.) in processed files
 4. Stores valid results in a map
 5. Adds #include statements to EventDispatcher.h
 6. Updates InitializeMappings() function with all generated code
+7. Updates InitializeBeans() with eager startup registrations for SINGLETON beans
+
+With --generated-dir, steps 3 and 5-7 write HttpRequestDispatcherGenerated.h and the
+.inc files it names into that directory instead, and no source or library file is
+modified. HttpRequestDispatcher.h picks them up through __has_include. Sources are not
+processed by DI in that mode, so the generated header includes the component headers
+(whose generated parts hold their Implementation<>, see di_bean_parts.py) rather than
+the interface headers.
 """
 
 import argparse
+import functools
 import sys
 import os
 import re
@@ -26,12 +36,23 @@ try:
     import L5_generate_all_endpoints as L5_generate_code_for_file
     import L3_get_endpoint_details
     import L1_find_class_header
+    import L5_generate_bean_startup
+    import codegen_cache
+    import codegen_parallel
+    import source_index
 except ImportError as e:
     # print(f"Error: Could not import required modules: {e}")
     # print("Make sure L5_generate_all_endpoints.py, L3_get_endpoint_details.py, and L1_find_class_header.py are in the springbootplusplus-web_core directory.")
     sys.exit(1)
 
 
+# Files written to --generated-dir (HttpRequestDispatcher.h includes them by these names)
+GENERATED_HEADER_FILE = "HttpRequestDispatcherGenerated.h"
+GENERATED_MAPPINGS_FILE = "HttpRequestDispatcherMappings.inc"
+GENERATED_BEANS_FILE = "HttpRequestDispatcherBeans.inc"
+GENERATED_BANNER = "// Generated by springbootplusplus-web pre-build (L6_generate_code_for_all_sources.py). Do not edit.\n"
+
+
 def find_cpp_files(include_paths: List[str], exclude_paths: List[str]) -> List[str]:
     """
     Find all C++ source files in the specified include/exclude paths.
@@ -92,8 +113,7 @@ def comment_rest_macros(file_path: str, dry_run: bool = False) -> bool:
         True if file was modified successfully or would be modified, False otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
         
         # Patterns for @RestController annotation (search for /* @RestController */ or /*@RestController*/)
         rest_controller_annotation_pattern = re.compile(r'/\*\s*@RestController\s*\*/')
@@ -112,6 +132,10 @@ def comment_rest_macros(file_path: str, dry_run: bool = False) -> bool:
             'PatchMapping': (re.compile(r'/\*\s*@PatchMapping\s*\(\s*["\']([^"\']+)["\']\s*\)\s*\*/'), re.compile(r'/\*--\s*@PatchMapping\s*\(\s*["\'][^"\']+["\']\s*\)\s*--\*/'))
         }
         
+        # Pattern for the per-route body size annotation (value is unquoted, e.g. /* @MaxBodySize(64KB) */)
+        max_body_size_annotation_pattern = re.compile(r'/\*\s*@MaxBodySize\s*\(\s*([^)]*?)\s*\)\s*\*/')
+        max_body_size_processed_pattern = re.compile(r'/\*--\s*@MaxBodySize\s*\([^)]*\)\s*--\*/')
+        
         # Legacy REST-related macros (for backward compatibility, will be commented out)
         rest_macros = [
             'RestController', 'RequestMapping', 'GetMapping', 'PostMapping',
@@ -143,6 +167,23 @@ def comment_rest_macros(file_path: str, dry_run: bool = False) -> bool:
                 modified = True
                 continue
             
+            # Process @MaxBodySize annotation
+            if max_body_size_processed_pattern.search(stripped_line):
+                modified_lines.append(line)
+                continue
+            
+            max_body_size_match = max_body_size_annotation_pattern.search(stripped_line)
+            if max_body_size_match:
+                indent = len(line) - len(line.lstrip())
+                indent_str = line[:indent]
+                processed_line = f"{indent_str}/*--@MaxBodySize({max_body_size_match.group(1)})--*/\n"
+                if not dry_run:
+                    modified_lines.append(processed_line)
+                else:
+                    modified_lines.append(line)
+                modified = True
+                continue
+            
             # Process other REST mapping annotations
             annotation_processed = False
             for annotation_name, (annotation_pattern, processed_pattern) in rest_mapping_annotations.items():
@@ -197,8 +238,7 @@ def comment_rest_macros(file_path: str, dry_run: bool = False) -> bool:
                 modified_lines.append(line)
         
         if modified and not dry_run:
-            with open(file_path, 'w', encoding='utf-8') as file:
-                file.writelines(modified_lines)
+            codegen_parallel.write_file_atomic(file_path, ''.join(modified_lines))
             # print(f"✓ Processed REST annotations/macros in: {file_path}")
         elif modified and dry_run:
             # print(f"  Would process REST annotations/macros in: {file_path}")
@@ -216,58 +256,96 @@ def comment_rest_macros(file_path: str, dry_run: bool = False) -> bool:
         return False
 
 
-def generate_code_map(cpp_files: List[str], dry_run: bool = False) -> Dict[str, Dict[str, str]]:
+def generate_code_for_source(file_path: str, dry_run: bool = False, mark_processed: bool = True) -> Optional[Dict[str, str]]:
+    """
+    Generate the endpoint code of one source file and mark its REST annotations as processed.
+    Runs in a worker process; touches no file other than file_path.
+    
+    Args:
+        file_path: Path to the C++ file
+        dry_run: If True, don't actually comment macros
+        mark_processed: If False, leave the file untouched (generated-directory mode)
+        
+    Returns:
+        Dictionary with 'code' and 'interface_name' keys, or None if the file has no RestController
+    """
+    generated_code = L5_generate_code_for_file.generate_code_for_file(file_path)
+    
+    # Only keep valid code (not empty, not None)
+    if not generated_code or not generated_code.strip():
+        return None
+    
+    # Get interface name from the file
+    class_info = L3_get_endpoint_details.find_class_and_interface(file_path)
+    interface_name = class_info['interface_name'] if class_info else None
+    
+    # Mark REST-related annotations as processed in this file
+    if mark_processed:
+        comment_rest_macros(file_path, dry_run=dry_run)
+    
+    return {
+        'code': generated_code,
+        'interface_name': interface_name
+    }
+
+
+def generate_code_map(cpp_files: List[str], dry_run: bool = False, cache: Optional[codegen_cache.CodegenCache] = None, jobs: Optional[int] = None, mark_processed: bool = True) -> Dict[str, Dict[str, str]]:
     """
     Generate code for all source files and store valid results in a map.
     Also comments out REST-related macros in processed files.
     
+    Files are analyzed in parallel; the map is filled in cpp_files order, so the
+    generated code does not depend on the number of jobs.
+    
     Args:
         cpp_files: List of C++ file paths to process
         dry_run: If True, don't actually comment macros, just show what would be done
+        cache: Optional codegen cache; files whose content hash is cached are not reparsed
+        jobs: Number of worker processes (None for all cores, 1 for serial)
+        mark_processed: If False, read the sources without marking their annotations
         
     Returns:
         Dictionary mapping file paths (absolute) to dictionaries with 'code' and 'interface_name' keys
     """
     # print("🔄 Generating code for files with RestController...")
     
-    code_map = {}
-    processed_count = 0
-    skipped_count = 0
+    results = {}
+    content_hashes = {}
+    pending_files = []
     
+    # Reuse the result of a previous run if the file has not changed since
     for file_path in cpp_files:
-        # Generate code for this file
-        generated_code = L5_generate_code_for_file.generate_code_for_file(file_path)
-        
-        # Only add to map if code is valid (not empty, not None)
-        if generated_code and generated_code.strip():
-            # Get interface name from the file
-            class_info = L3_get_endpoint_details.find_class_and_interface(file_path)
-            interface_name = class_info['interface_name'] if class_info else None
-            
-            code_map[file_path] = {
-                'code': generated_code,
-                'interface_name': interface_name
-            }
-            processed_count += 1
-            
-            # Mark REST-related annotations as processed in this file
-            if not dry_run:
-                # print(f"  Processing REST annotations in: {file_path}")
-                pass
-            else:
-                # print(f"  Would process REST annotations in: {file_path}")
-                pass
-            comment_rest_macros(file_path, dry_run=dry_run)
-        else:
-            skipped_count += 1
+        if cache:
+            content_hashes[file_path] = codegen_cache.hash_file(file_path)
+            hit, cached = cache.lookup(file_path, content_hashes[file_path], 'endpoints')
+            if hit:
+                results[file_path] = cached
+                continue
+        pending_files.append(file_path)
+    
+    generated = codegen_parallel.parallel_map(
+        functools.partial(generate_code_for_source, dry_run=dry_run, mark_processed=mark_processed), pending_files, jobs)
+    
+    for file_path, file_result in zip(pending_files, generated):
+        results[file_path] = file_result
+        if cache:
+            # Key controller results by the content after the annotations were marked
+            content_hash = codegen_cache.hash_file(file_path) if file_result and mark_processed else content_hashes[file_path]
+            cache.store(file_path, content_hash, 'endpoints', file_result)
     
-    # print(f"✅ Processed {processed_count} file(s) with RestController")
-    # print(f"⏭️  Skipped {skipped_count} file(s) without RestController")
+    # Merge in discovery order
+    code_map = {}
+    for file_path in cpp_files:
+        if results.get(file_path):
+            code_map[file_path] = results[file_path]
+    
+    # print(f"✅ Processed {len(code_map)} file(s) with RestController")
+    # print(f"⏭️  Skipped {len(cpp_files) - len(code_map)} file(s) without RestController")
     
     return code_map
 
 
-def generate_includes(code_map: Dict[str, Dict[str, str]], project_root: Optional[str] = None, include_paths: List[str] = None, exclude_paths: List[str] = None) -> List[str]:
+def generate_includes(code_map: Dict[str, Dict[str, str]], project_root: Optional[str] = None, include_paths: List[str] = None, exclude_paths: List[str] = None, component_headers: bool = False) -> List[str]:
     """
     Generate #include statements for interface headers of all files in the code map.
     
@@ -276,12 +354,21 @@ def generate_includes(code_map: Dict[str, Dict[str, str]], project_root: Optiona
         project_root: Project root directory (if None, will try to find it)
         include_paths: List of include paths to search for interface headers
         exclude_paths: List of exclude paths to avoid when searching
+        component_headers: Include the files of the code map themselves (--generated-dir, where
+                           interface headers do not include their implementations); source
+                           files are skipped
         
     Returns:
         List of #include statements for interface headers
     """
     includes = []
     
+    if component_headers:
+        for file_path in sorted(code_map.keys()):
+            if Path(file_path).suffix.lower() in ('.h', '.hpp', '.hh', '.hxx'):
+                includes.append(f'#include "{Path(file_path).resolve().as_posix()}"')
+        return includes
+    
     # Find project root if not provided
     if project_root is None:
         # Try to find project root by looking for common markers
@@ -341,8 +428,7 @@ def add_includes_to_event_dispatcher(file_path: str, includes: List[str]) -> boo
         True if successful, False otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as f:
-            lines = f.readlines()
+        lines = source_index.load(file_path).lines
         
         # Find line 6 (index 5) which has #include "01-IEventDispatcher.h"
         # We want to add includes after this line
@@ -352,12 +438,16 @@ def add_includes_to_event_dispatcher(file_path: str, includes: List[str]) -> boo
             # print(f"Error: Cannot find insertion point in {file_path}")
             return False
         
-        # Remove all existing controller includes (they will be replaced with correct ones)
+        original_lines = list(lines)
+        
+        # Remove stale controller includes (the ones still wanted are kept in place,
+        # so regenerating the same includes leaves the file byte-identical)
         # Look for includes that point to controller files
         import re
+        wanted_includes = {include.strip() for include in includes}
         lines_to_remove = []
         for i, line in enumerate(lines):
-            if line.strip().startswith('#include'):
+            if line.strip().startswith('#include') and line.strip() not in wanted_includes:
                 # Check if this is a controller include (contains "controller" in path or matches pattern)
                 if 'controller' in line.lower() or re.search(r'/\d+-[A-Za-z0-9_]*Controller\.h', line):
                     lines_to_remove.append(i)
@@ -393,9 +483,12 @@ def add_includes_to_event_dispatcher(file_path: str, includes: List[str]) -> boo
         if new_includes:
             lines[insert_index:insert_index] = new_includes + ['\n']  # Add blank line after includes
         
+        # Same includes as before: leave the file (and its timestamp) untouched
+        if lines == original_lines:
+            return True
+        
         # Write back to file
-        with open(file_path, 'w', encoding='utf-8') as f:
-            f.writelines(lines)
+        codegen_parallel.write_file_atomic(file_path, ''.join(lines))
         
         # print(f"✅ Added {len(new_includes)} include(s) to EventDispatcher.h")
         return True
@@ -413,21 +506,64 @@ def update_initialize_mappings(file_path: str, code_content: str) -> bool:
         file_path: Path to EventDispatcher.h
         code_content: Code content to insert into InitializeMappings()
         
+    Returns:
+        True if successful, False otherwise
+    """
+    return update_generated_function(file_path, 'InitializeMappings', code_content)
+
+
+def update_initialize_beans(file_path: str, code_content: str) -> bool:
+    """
+    Replace the InitializeBeans() function body with the provided code.
+    
+    Args:
+        file_path: Path to HttpRequestDispatcher.h
+        code_content: BeanStartup registrations to insert into InitializeBeans()
+        
+    Returns:
+        True if successful, False otherwise
+    """
+    return update_generated_function(file_path, 'InitializeBeans', code_content)
+
+
+def indent_function_body(code_content: str) -> str:
+    """
+    Indent generated statements for the body of a dispatcher member function.
+    
+    Args:
+        code_content: Generated statements
+        
+    Returns:
+        Statements indented by 8 spaces (blank lines left empty)
+    """
+    code_lines = code_content.strip().split('\n')
+    indented_lines = ['        ' + line if line.strip() else '' for line in code_lines]
+    return '\n'.join(indented_lines)
+
+
+def update_generated_function(file_path: str, function_name: str, code_content: str) -> bool:
+    """
+    Replace the body of a generated Private Void <function_name>() function with the provided code.
+    
+    Args:
+        file_path: Path to the dispatcher header
+        function_name: Name of the function (e.g. InitializeMappings)
+        code_content: Code content to insert into the function
+        
     Returns:
         True if successful, False otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as f:
-            content = f.read()
+        content = source_index.load(file_path).content
         
-        # Pattern to match InitializeMappings() function
+        # Pattern to match the function
         # Matches: Private Void InitializeMappings() { ... }
         # We need to find the matching closing brace by counting braces, not just the first }
-        pattern = r'(Private\s+Void\s+InitializeMappings\s*\(\s*\)\s*\{)'
+        pattern = r'(Private\s+Void\s+' + re.escape(function_name) + r'\s*\(\s*\)\s*\{)'
         
         match = re.search(pattern, content, flags=re.MULTILINE)
         if not match:
-            # print("⚠️  Warning: Could not find InitializeMappings() function to update")
+            # print(f"⚠️  Warning: Could not find {function_name}() function to update")
             return False
         
         # Find the matching closing brace by counting braces
@@ -443,7 +579,7 @@ def update_initialize_mappings(file_path: str, code_content: str) -> bool:
             pos += 1
         
         if brace_count != 0:
-            # print("⚠️  Warning: Could not find matching closing brace for InitializeMappings()")
+            # print(f"⚠️  Warning: Could not find matching closing brace for {function_name}()")
             return False
         
         # Extract the function header and footer
@@ -452,9 +588,7 @@ def update_initialize_mappings(file_path: str, code_content: str) -> bool:
         
         # Split code_content into lines and indent each line
         if code_content.strip():
-            code_lines = code_content.strip().split('\n')
-            indented_lines = ['        ' + line if line.strip() else '' for line in code_lines]
-            indented_code = '\n'.join(indented_lines)
+            indented_code = indent_function_body(code_content)
             replacement = f"{function_header}\n{indented_code}\n    {function_footer}"
         else:
             replacement = f"{function_header}\n    {function_footer}"
@@ -463,18 +597,58 @@ def update_initialize_mappings(file_path: str, code_content: str) -> bool:
         new_content = content[:match.start()] + replacement + content[pos:]
         
         if new_content == content:
-            # print("⚠️  Warning: Could not find InitializeMappings() function to update")
-            return False
+            # Already up to date: leave the file (and its timestamp) untouched
+            return True
         
         # Write back to file
-        with open(file_path, 'w', encoding='utf-8') as f:
-            f.write(new_content)
+        codegen_parallel.write_file_atomic(file_path, new_content)
         
-        # print("✅ Updated InitializeMappings() function in EventDispatcher.h")
+        # print(f"✅ Updated {function_name}() function in {file_path}")
         return True
         
     except Exception as e:
-        # print(f"Error updating InitializeMappings(): {e}")
+        # print(f"Error updating {function_name}(): {e}")
+        return False
+
+
+def write_generated_files(generated_dir: str, includes: List[str], mappings_code: str, beans_code: str) -> bool:
+    """
+    Write the dispatcher's generated code into generated_dir instead of rewriting
+    HttpRequestDispatcher.h. Files whose content did not change are not rewritten,
+    so an unchanged project does not recompile.
+    
+    Args:
+        generated_dir: Output directory (on the include path of the build)
+        includes: #include statements for controller and bean component headers
+        mappings_code: Statements for InitializeMappings()
+        beans_code: Statements for InitializeBeans()
+        
+    Returns:
+        True if successful, False otherwise
+    """
+    try:
+        os.makedirs(generated_dir, exist_ok=True)
+        
+        header_lines = [GENERATED_BANNER,
+                        '#ifndef HTTP_REQUEST_DISPATCHER_GENERATED_H\n',
+                        '#define HTTP_REQUEST_DISPATCHER_GENERATED_H\n',
+                        '\n']
+        header_lines.extend(include + '\n' for include in includes)
+        header_lines.extend(['\n', '#endif // HTTP_REQUEST_DISPATCHER_GENERATED_H\n'])
+        
+        outputs = {
+            GENERATED_HEADER_FILE: ''.join(header_lines),
+            GENERATED_MAPPINGS_FILE: GENERATED_BANNER + (indent_function_body(mappings_code) + '\n' if mappings_code.strip() else ''),
+            GENERATED_BEANS_FILE: GENERATED_BANNER + (indent_function_body(beans_code) + '\n' if beans_code.strip() else '')
+        }
+        for file_name, content in outputs.items():
+            codegen_cache.write_if_changed(os.path.join(generated_dir, file_name), content)
+        
+        # print(f"✅ Wrote generated dispatcher code to {generated_dir}")
+        return True
+        
+    except Exception as e:
+        # print(f"Error writing generated files to '{generated_dir}': {e}")
         return False
 
 
@@ -512,6 +686,12 @@ Examples:
         help="Path to EventDispatcher.h file (default: src/01-framework/06-event/04-dispatcher/01-EventDispatcher.h)"
     )
     
+    parser.add_argument(
+        "--generated-dir",
+        default=None,
+        help="Write the generated dispatcher code into this directory and leave sources untouched (default: rewrite them in place)"
+    )
+    
     parser.add_argument(
         "--dry-run",
         action="store_true",
@@ -524,6 +704,26 @@ Examples:
         help="Show detailed summary of results"
     )
     
+    parser.add_argument(
+        "--jobs",
+        "-j",
+        type=int,
+        default=None,
+        help="Number of worker processes for per-file analysis (default: all cores)"
+    )
+    
+    parser.add_argument(
+        "--cache-file",
+        default=codegen_cache.DEFAULT_CACHE_FILE,
+        help=f"Codegen cache keyed by file content hash (default: {codegen_cache.DEFAULT_CACHE_FILE})"
+    )
+    
+    parser.add_argument(
+        "--no-cache",
+        action="store_true",
+        help="Reparse every file and do not update the cache"
+    )
+    
     args = parser.parse_args()
     
     # Show configuration
@@ -545,11 +745,23 @@ Examples:
     
     # print(f"📁 Found {len(cpp_files)} C++ source files")
     
-    # Generate code map (this will also comment out REST macros)
-    code_map = generate_code_map(cpp_files, dry_run=args.dry_run)
+    # Results of unchanged files come from the cache
+    cache = None
+    if not args.no_cache and not args.dry_run:
+        cache = codegen_cache.CodegenCache(args.cache_file)
+        cache.prune(cpp_files)
+    
+    # Generate code map (this will also comment out REST macros unless writing to --generated-dir)
+    generated_dir = args.generated_dir
+    code_map = generate_code_map(cpp_files, dry_run=args.dry_run, cache=cache, jobs=args.jobs,
+                                 mark_processed=not generated_dir)
     
-    if not code_map:
+    # Annotations stay unprocessed in generated mode, so the generated files always
+    # describe every controller and are rewritten even when none is left
+    if not code_map and not generated_dir:
         # print("⚠️  No files with RestController found. Nothing to update.")
+        if cache:
+            cache.save()
         sys.exit(0)
     
     # print(f"\n📊 Generated code for {len(code_map)} file(s)")
@@ -585,8 +797,8 @@ Examples:
     # Go up one more level to get to arduinolib2
     arduinolib2_root = os.path.dirname(project_root)  # This gives arduinolib2
     
-    # Generate includes (for interface headers)
-    includes = generate_includes(code_map, project_root, args.include, args.exclude)
+    # Generate includes (for interface headers, or the component headers in generated mode)
+    includes = generate_includes(code_map, project_root, args.include, args.exclude, component_headers=bool(generated_dir))
     
     # Add SerializeUtility.h include (required for serialize template function)
     serialize_utility_path = os.path.join(project_root, "src/01-framework/01-core/01-serializer/02-generic/04-SerializeUtility.h")
@@ -625,22 +837,50 @@ Examples:
     
     # Add includes to EventDispatcher.h
     dispatcher_file = args.dispatcher_file
-    if not os.path.exists(dispatcher_file):
+    if not os.path.exists(dispatcher_file) and not generated_dir:
         # print(f"Error: EventDispatcher.h file not found at '{dispatcher_file}'")
         sys.exit(1)
     
-    if not add_includes_to_event_dispatcher(dispatcher_file, includes):
-        # print("Error: Failed to add includes to EventDispatcher.h")
-        sys.exit(1)
+    # Interface headers of SINGLETON beans that are not controllers (for InitializeBeans())
+    beans = [bean for bean in L5_generate_bean_startup.find_bean_definitions(cpp_files, cache=cache, jobs=args.jobs)
+             if Path(bean['file_path']).resolve() != Path(dispatcher_file).resolve()]
+    if generated_dir:
+        # A component defined in a source file is only visible in its own translation unit
+        beans = [bean for bean in beans if Path(bean['file_path']).suffix.lower() in ('.h', '.hpp', '.hh', '.hxx')]
+    bean_map = {bean['file_path']: {'interface_name': bean['interface_name']}
+                for bean in beans if bean['file_path'] not in code_map and bean['scope'] == 'SINGLETON'}
+    for include in generate_includes(bean_map, project_root, args.include, args.exclude, component_headers=bool(generated_dir)):
+        if include not in includes:
+            includes.append(include)
     
     # Concatenate all code values
     all_code = '\n\n'.join([info['code'] for info in code_map.values()])
     
+    if generated_dir:
+        if not write_generated_files(generated_dir, includes, all_code,
+                                     L5_generate_bean_startup.generate_bean_startup_code(beans)):
+            sys.exit(1)
+        if cache:
+            cache.save()
+        sys.exit(0)
+    
+    if not add_includes_to_event_dispatcher(dispatcher_file, includes):
+        # print("Error: Failed to add includes to EventDispatcher.h")
+        sys.exit(1)
+    
     # Update InitializeMappings() function
     if not update_initialize_mappings(dispatcher_file, all_code):
         # print("Error: Failed to update InitializeMappings() function")
         sys.exit(1)
     
+    # Register SINGLETON beans for eager startup, ordered by the @Autowired graph
+    if not update_initialize_beans(dispatcher_file, L5_generate_bean_startup.generate_bean_startup_code(beans)):
+        # print("Warning: InitializeBeans() not found, beans will be constructed lazily")
+        pass
+    
+    if cache:
+        cache.save()
+    
     # print("\n✅ Successfully updated EventDispatcher.h")
     # print(f"   - Added {len(includes)} include(s)")
     # print(f"   - Updated InitializeMappings() with code from {len(code_map)} controller(s)")
@@ -665,6 +905,10 @@ __all__ = [
     'generate_includes',
     'add_includes_to_event_dispatcher',
     'update_initialize_mappings',
+    'update_initialize_beans',
+    'indent_function_body',
+    'update_generated_function',
+    'write_generated_files',
     'main'
 ]
 
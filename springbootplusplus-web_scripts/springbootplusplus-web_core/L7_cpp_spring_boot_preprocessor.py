@@ -20,7 +20,7 @@ from typing import Dict, Any
 SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
 
 
-def run_l6_generate_code(include_paths: list, exclude_paths: list, dispatcher_file: str, dry_run: bool = False) -> Dict[str, Any]:
+def run_l6_generate_code(include_paths: list, exclude_paths: list, dispatcher_file: str, dry_run: bool = False, stage_args: list = None, generated_dir: str = None) -> Dict[str, Any]:
     """
     Run L6_generate_code_for_all_sources.py.
     
@@ -29,6 +29,8 @@ def run_l6_generate_code(include_paths: list, exclude_paths: list, dispatcher_fi
         exclude_paths: List of exclude paths to avoid
         dispatcher_file: Path to EventDispatcher.h file
         dry_run: Whether to run in dry-run mode
+        stage_args: Arguments passed through to both stages (--cache-file / --no-cache / --jobs)
+        generated_dir: Directory for the generated dispatcher code (None to rewrite the dispatcher in place)
         
     Returns:
         Dictionary with results
@@ -50,10 +52,18 @@ def run_l6_generate_code(include_paths: list, exclude_paths: list, dispatcher_fi
         if dispatcher_file:
             cmd.extend(["--dispatcher-file", dispatcher_file])
         
+        # Write the generated code out of tree instead of into the dispatcher
+        if generated_dir:
+            cmd.extend(["--generated-dir", generated_dir])
+        
         # Add dry-run flag if specified
         if dry_run:
             cmd.append("--dry-run")
         
+        # Both stages share the codegen cache and the worker count
+        if stage_args:
+            cmd.extend(stage_args)
+        
         # Run the command
         result = subprocess.run(cmd, capture_output=False, text=True, cwd=".")
         
@@ -80,7 +90,7 @@ def run_l6_generate_code(include_paths: list, exclude_paths: list, dispatcher_fi
         return error_result
 
 
-def run_l6_di_preprocessor(include_paths: list, exclude_paths: list, dry_run: bool = False) -> Dict[str, Any]:
+def run_l6_di_preprocessor(include_paths: list, exclude_paths: list, dry_run: bool = False, stage_args: list = None, generated_dir: str = None) -> Dict[str, Any]:
     """
     Run L6_cpp_di_preprocessor.py.
     
@@ -88,6 +98,8 @@ def run_l6_di_preprocessor(include_paths: list, exclude_paths: list, dry_run: bo
         include_paths: List of include paths to search in
         exclude_paths: List of exclude paths to avoid
         dry_run: Whether to run in dry-run mode
+        stage_args: Arguments passed through to both stages (--cache-file / --no-cache / --jobs)
+        generated_dir: Directory for the processed bean headers (None to process the sources in place)
         
     Returns:
         Dictionary with results
@@ -105,10 +117,18 @@ def run_l6_di_preprocessor(include_paths: list, exclude_paths: list, dry_run: bo
         if exclude_paths:
             cmd.extend(["--exclude"] + exclude_paths)
         
+        # Process a copy of the tree and emit the processed headers out of tree
+        if generated_dir:
+            cmd.extend(["--generated-dir", generated_dir])
+        
         # Add dry-run flag if specified
         if dry_run:
             cmd.append("--dry-run")
         
+        # Both stages share the codegen cache and the worker count
+        if stage_args:
+            cmd.extend(stage_args)
+        
         # Run the command
         result = subprocess.run(cmd, capture_output=False, text=True, cwd=".")
         
@@ -225,6 +245,32 @@ Examples:
         help="Show detailed summary of results"
     )
     
+    parser.add_argument(
+        "--generated-dir",
+        default=None,
+        help="Write the generated dispatcher code and the processed bean headers into this directory and leave all sources untouched"
+    )
+    
+    parser.add_argument(
+        "--jobs",
+        "-j",
+        type=int,
+        default=None,
+        help="Number of parallel workers per stage (default: all cores); the two stages still run one after the other"
+    )
+    
+    parser.add_argument(
+        "--cache-file",
+        default=None,
+        help="Codegen cache keyed by file content hash (default: .springbootplusplus-web-cache.json)"
+    )
+    
+    parser.add_argument(
+        "--no-cache",
+        action="store_true",
+        help="Reprocess every file and do not update the cache"
+    )
+    
     args = parser.parse_args()
     
     # Show configuration
@@ -238,12 +284,22 @@ Examples:
     # print("🚀 Starting complete preprocessing workflow...")
     # print("=" * 80 + "\n")
     
+    stage_args = []
+    if args.cache_file:
+        stage_args.extend(["--cache-file", args.cache_file])
+    if args.no_cache:
+        stage_args.append("--no-cache")
+    if args.jobs:
+        stage_args.extend(["--jobs", str(args.jobs)])
+    
     # Step 1: Generate endpoint mappings
     step1_result = run_l6_generate_code(
         include_paths=args.include,
         exclude_paths=args.exclude,
         dispatcher_file=args.dispatcher_file,
-        dry_run=args.dry_run
+        dry_run=args.dry_run,
+        stage_args=stage_args,
+        generated_dir=args.generated_dir
     )
     
     # If step 1 failed and not in dry-run, we might want to continue or stop
@@ -254,7 +310,9 @@ Examples:
     step2_result = run_l6_di_preprocessor(
         include_paths=args.include,
         exclude_paths=args.exclude,
-        dry_run=args.dry_run
+        dry_run=args.dry_run,
+        stage_args=stage_args,
+        generated_dir=args.generated_dir
     )
     
     # Display summary
@@ -8,6 +8,8 @@ import re
 import argparse
 from pathlib import Path
 from typing import List, Dict, Optional, Tuple
+import source_index
+from codegen_parallel import write_file_atomic
 
 
 def find_last_endif(file_path: str) -> Optional[Tuple[int, str]]:
@@ -21,8 +23,7 @@ def find_last_endif(file_path: str) -> Optional[Tuple[int, str]]:
         Tuple of (line_number, line_content) or None if not found
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return None
@@ -88,8 +89,7 @@ def inject_header_include(file_path: str, header_path: str, dry_run: bool = Fals
         
         # Step 3: Check if include already exists
         try:
-            with open(file_path, 'r', encoding='utf-8') as file:
-                existing_lines = file.readlines()
+            existing_lines = source_index.load(file_path).lines
             
             # Check if this include already exists
             include_statement_stripped = include_statement.strip()
@@ -106,15 +106,13 @@ def inject_header_include(file_path: str, header_path: str, dry_run: bool = Fals
         else:
             # Actually inject the code
             try:
-                with open(file_path, 'r', encoding='utf-8') as file:
-                    lines = file.readlines()
+                lines = source_index.load(file_path).lines
                 
                 # Insert the #include statement before the #endif line
                 lines.insert(line_num - 1, include_statement)
                 
                 # Write back to file
-                with open(file_path, 'w', encoding='utf-8') as file:
-                    file.writelines(lines)
+                write_file_atomic(file_path, ''.join(lines))
                 
                 results['success'] = True
                 
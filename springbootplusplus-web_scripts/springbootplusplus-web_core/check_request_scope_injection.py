@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+"""
+Script to check that @Scope("REQUEST") beans are only injected where they cannot outlive their request.
+
+A REQUEST bean lives in the RequestScope of the request being dispatched and is destroyed
+when DispatchRequest returns; GetInstance() hands out a non-owning pointer. A SINGLETON or
+POOLED bean keeps its @Autowired fields across requests, so a REQUEST bean injected into one
+would be used after it was destroyed (e.g. a lazy singleton first resolved inside a request).
+Such injections are rejected; inject into a REQUEST or PROTOTYPE bean instead.
+
+Both unprocessed (/* @Autowired */) and processed (/*--@Autowired--*/) injections are checked,
+so the result does not depend on whether DI already ran on a file.
+"""
+
+import re
+import argparse
+import sys
+from pathlib import Path
+from typing import List, Dict, Tuple
+
+try:
+    import source_index
+    from L2_get_file_scope import get_base_scope
+    from find_interface_names import find_interface_names
+    from L4_process_autowired import parse_variable_declaration, parse_constructor_parameters
+except ImportError:
+    # print("Error: Could not import required modules.")
+    sys.exit(1)
+
+
+# Scopes whose instances outlive a request
+LONG_LIVED_SCOPES = ('SINGLETON', 'POOLED')
+
+COMPONENT_ANNOTATIONS = ('Component', 'Service', 'RestController')
+
+autowired_annotation_pattern = re.compile(r'/\*\s*@Autowired\s*\*/')
+autowired_processed_pattern = re.compile(r'/\*--\s*@Autowired\s*--\*/')
+injected_type_pattern = re.compile(r'Implementation<\s*([A-Za-z_][A-Za-z0-9_:]*)\s*>::type::GetInstance\(\)')
+
+# Lines scanned after an @Autowired annotation for the declaration it belongs to
+MAX_DECLARATION_LINES = 20
+
+
+def is_component(file_path: str) -> bool:
+    """
+    Check whether a file declares a bean (@Component, @Service or @RestController, processed or not).
+
+    Args:
+        file_path: Path to the C++ file
+
+    Returns:
+        True if the file declares a bean
+    """
+    source = source_index.get_source(file_path)
+    if source is None:
+        return False
+    return any(source.has_annotation(name) for name in COMPONENT_ANNOTATIONS)
+
+
+def find_injected_types(file_path: str) -> List[Tuple[int, str]]:
+    """
+    Find the interfaces injected into a file through @Autowired fields and constructors.
+
+    Args:
+        file_path: Path to the C++ file
+
+    Returns:
+        List of (line number of the @Autowired annotation, interface name)
+    """
+    source = source_index.get_source(file_path)
+    if source is None:
+        return []
+    lines = source.stripped_lines
+
+    injected = []
+    for index, line in enumerate(lines):
+        processed = autowired_processed_pattern.search(line) is not None
+        if not processed and autowired_annotation_pattern.search(line) is None:
+            continue
+
+        # Declaration that follows the annotation, up to its ';' or '{'
+        declaration = ""
+        for next_line in lines[index + 1:index + 1 + MAX_DECLARATION_LINES]:
+            declaration += " " + next_line
+            if ';' in next_line or '{' in next_line:
+                break
+
+        if processed:
+            names = injected_type_pattern.findall(declaration)
+        else:
+            constructor = re.search(r'\(([^)]*)\)', declaration)
+            variable = parse_variable_declaration(declaration.strip())
+            if variable:
+                names = [variable['variable_base_type']]
+            elif constructor:
+                names = [param['base_type'] for param in parse_constructor_parameters(constructor.group(1))]
+            else:
+                names = []
+        injected.extend((index + 1, name.split('::')[-1]) for name in names)
+    return injected
+
+
+def find_request_scope_violations(cpp_files: List[str]) -> List[Dict[str, str]]:
+    """
+    Find REQUEST beans injected into SINGLETON or POOLED beans.
+
+    Args:
+        cpp_files: All scanned C++ files
+
+    Returns:
+        List of dictionaries with 'file_path', 'line_number', 'consumer', 'consumer_scope',
+        'interface' and 'implementation' keys
+    """
+    components = [file_path for file_path in cpp_files if is_component(file_path)]
+
+    # Interface -> (implementation class, scope) of the REQUEST beans
+    request_beans = {}
+    for file_path in components:
+        if get_base_scope(file_path) != 'REQUEST':
+            continue
+        source = source_index.get_source(file_path)
+        interface_names = find_interface_names(file_path)
+        if source and source.class_names and interface_names:
+            request_beans[interface_names[0]] = source.class_names[0]
+
+    violations = []
+    if not request_beans:
+        return violations
+    for file_path in components:
+        consumer_scope = get_base_scope(file_path)
+        if consumer_scope not in LONG_LIVED_SCOPES:
+            continue
+        source = source_index.get_source(file_path)
+        consumer = source.class_names[0] if source and source.class_names else Path(file_path).stem
+        for line_number, interface in find_injected_types(file_path):
+            if interface in request_beans:
+                violations.append({
+                    'file_path': str(Path(file_path).resolve()),
+                    'line_number': line_number,
+                    'consumer': consumer,
+                    'consumer_scope': consumer_scope,
+                    'interface': interface,
+                    'implementation': request_beans[interface],
+                })
+    return violations
+
+
+def format_violation(violation: Dict[str, str]) -> str:
+    """
+    Error message for one violation.
+
+    Args:
+        violation: Entry of find_request_scope_violations
+
+    Returns:
+        Message without location
+    """
+    return (f"@Scope(\"REQUEST\") bean {violation['implementation']} ({violation['interface']}) cannot be "
+            f"@Autowired into {violation['consumer_scope']} bean {violation['consumer']}: it is destroyed when its "
+            f"request ends; make {violation['consumer']} REQUEST or PROTOTYPE scoped")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Reject @Scope(\"REQUEST\") beans injected into SINGLETON or POOLED beans"
+    )
+    parser.add_argument(
+        "files",
+        nargs="+",
+        help="All C++ files of the application"
+    )
+
+    args = parser.parse_args()
+
+    violations = find_request_scope_violations(args.files)
+    for violation in violations:
+        print(f"{violation['file_path']}:{violation['line_number']}: error: {format_violation(violation)}", file=sys.stderr)
+    sys.exit(1 if violations else 0)
+
+
+# Export functions for other scripts to import
+__all__ = [
+    'LONG_LIVED_SCOPES',
+    'is_component',
+    'find_injected_types',
+    'find_request_scope_violations',
+    'format_violation',
+    'main'
+]
+
+
+if __name__ == "__main__":
+    main()
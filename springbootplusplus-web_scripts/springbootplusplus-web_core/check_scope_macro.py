@@ -1,15 +1,18 @@
 #!/usr/bin/env python3
 """
 Script to check if C++ files contain the @Scope annotation with valid values above class declarations.
-Only accepts @Scope("PROTOTYPE") or @Scope("SINGLETON"). Ignores processed annotations.
+Accepts @Scope("PROTOTYPE"), @Scope("SINGLETON"), @Scope("REQUEST") or @Scope("POOLED"). Ignores processed annotations.
 """
 
 import re
 import argparse
 from pathlib import Path
 from typing import List, Dict, Optional, Tuple, Set
+import source_index
+from codegen_parallel import write_file_atomic
 
 
+@source_index.cached_query
 def find_scope_macros(file_path: str) -> List[Dict[str, str]]:
     """
     Find all @Scope annotations in a C++ file and their context.
@@ -23,8 +26,7 @@ def find_scope_macros(file_path: str) -> List[Dict[str, str]]:
     scope_macros = []
     
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return []
@@ -34,8 +36,8 @@ def find_scope_macros(file_path: str) -> List[Dict[str, str]]:
     
     # Pattern to match @Scope annotation with parameter (search for /* @Scope("...") */ or /*@Scope("...")*/)
     # Also check for already processed /*--@Scope("...")--*/ pattern
-    scope_annotation_pattern = re.compile(r'/\*\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON)["\']\s*\)\s*\*/')
-    scope_processed_pattern = re.compile(r'/\*--\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON)["\']\s*\)\s*--\*/')
+    scope_annotation_pattern = re.compile(r'/\*\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON|REQUEST|POOLED)["\']\s*\)\s*\*/')
+    scope_processed_pattern = re.compile(r'/\*--\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON|REQUEST|POOLED)["\']\s*\)\s*--\*/')
     
     # Pattern to match class declarations
     class_pattern = r'class\s+([A-Za-z_][A-Za-z0-9_]*)\s*(?:[:{])'
@@ -106,7 +108,7 @@ def find_scope_macros(file_path: str) -> List[Dict[str, str]]:
                 'class_name': class_name,
                 'has_class': class_found,
                 'scope_value': scope_value,
-                'is_valid': scope_value in ['PROTOTYPE', 'SINGLETON']
+                'is_valid': scope_value in ['PROTOTYPE', 'SINGLETON', 'REQUEST', 'POOLED']
             })
         
         # Check for legacy SCOPE macro (for backward compatibility)
@@ -139,7 +141,7 @@ def find_scope_macros(file_path: str) -> List[Dict[str, str]]:
                 'class_name': class_name,
                 'has_class': class_found,
                 'scope_value': scope_value,
-                'is_valid': scope_value in ['PROTOTYPE', 'SINGLETON']
+                'is_valid': scope_value in ['PROTOTYPE', 'SINGLETON', 'REQUEST', 'POOLED']
             })
     
     return scope_macros
@@ -157,11 +159,10 @@ def check_scope_macro_exists(file_path: str) -> bool:
         True if @Scope annotation or SCOPE macro is found, False otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
         
-        scope_annotation_pattern = re.compile(r'///\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON)["\']\s*\)')
-        scope_processed_pattern = re.compile(r'/\*\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON)["\']\s*\)\s*\*/')
+        scope_annotation_pattern = re.compile(r'///\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON|REQUEST|POOLED)["\']\s*\)')
+        scope_processed_pattern = re.compile(r'/\*\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON|REQUEST|POOLED)["\']\s*\)\s*\*/')
         
         # Check each line for @Scope annotation
         for line in lines:
@@ -228,7 +229,7 @@ def validate_scope_macro_placement(file_path: str) -> Dict[str, any]:
             invalid_placements += 1
             issues.append(f"@Scope annotation at line {macro_info['line_number']} not followed by class declaration")
         
-        # Check scope value (must be PROTOTYPE or SINGLETON)
+        # Check scope value (must be PROTOTYPE, SINGLETON, REQUEST or POOLED)
         if macro_info['is_valid']:
             valid_values += 1
         else:
@@ -283,7 +284,7 @@ def validate_cpp_file(file_path: str) -> bool:
 def main():
     """Main function to handle command line arguments and execute the validation."""
     parser = argparse.ArgumentParser(
-        description="Check if C++ files contain @Scope annotation with valid values (PROTOTYPE/SINGLETON) above class declarations"
+        description="Check if C++ files contain @Scope annotation with valid values (PROTOTYPE/SINGLETON/REQUEST/POOLED) above class declarations"
     )
     parser.add_argument(
         "files", 
@@ -430,11 +431,10 @@ def mark_scope_annotation_processed(file_path: str) -> bool:
         True if file was modified successfully, False otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
         
-        scope_annotation_pattern = re.compile(r'/\*\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON)["\']\s*\)\s*\*/')
-        scope_processed_pattern = re.compile(r'/\*--\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON)["\']\s*\)\s*--\*/')
+        scope_annotation_pattern = re.compile(r'/\*\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON|REQUEST|POOLED)["\']\s*\)\s*\*/')
+        scope_processed_pattern = re.compile(r'/\*--\s*@Scope\s*\(\s*["\'](PROTOTYPE|SINGLETON|REQUEST|POOLED)["\']\s*\)\s*--\*/')
         
         modified = False
         modified_lines = []
@@ -472,8 +472,7 @@ def mark_scope_annotation_processed(file_path: str) -> bool:
         
         # Write back to file if modifications were made
         if modified:
-            with open(file_path, 'w', encoding='utf-8') as file:
-                file.writelines(modified_lines)
+            write_file_atomic(file_path, ''.join(modified_lines))
             # print(f"✓ Processed @Scope annotation in: {file_path}")
         else:
             # print(f"ℹ No @Scope annotation found to process in: {file_path}")
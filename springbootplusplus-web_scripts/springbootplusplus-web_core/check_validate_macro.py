@@ -8,8 +8,10 @@ import re
 import argparse
 from pathlib import Path
 from typing import List, Dict, Optional, Tuple, Set
+import source_index
 
 
+@source_index.cached_query
 def find_validate_macros(file_path: str) -> List[Dict[str, str]]:
     """
     Find all VALIDATE macros in a C++ file and their context.
@@ -23,8 +25,7 @@ def find_validate_macros(file_path: str) -> List[Dict[str, str]]:
     validate_macros = []
     
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            lines = file.readlines()
+        lines = source_index.load(file_path).lines
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return []
@@ -102,8 +103,7 @@ def check_validate_macro_exists(file_path: str) -> bool:
         True if VALIDATE macro is found, False otherwise
     """
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            content = file.read()
+        content = source_index.load(file_path).content
         
         # Simple pattern to check if VALIDATE exists anywhere
         return 'VALIDATE' in content
@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""
+Persistent cache for the code generation pipeline.
+
+Stores, per source file, the results the stages extracted from it (generated endpoint
+code, component/bean definitions, whether DI processing already ran), keyed by the
+SHA-256 of the file content and by the version of these scripts. A file whose content
+hash still matches is not reparsed; editing the file or any script in
+springbootplusplus-web_core invalidates its entry.
+
+Stages that rewrite a file themselves (marking annotations as processed) call
+advance() so the entry follows the file to its new content instead of being dropped.
+"""
+
+import hashlib
+import json
+import os
+import argparse
+from pathlib import Path
+from typing import Any, Dict, List, Optional, Tuple
+
+
+DEFAULT_CACHE_FILE = ".springbootplusplus-web-cache.json"
+
+_script_version = None
+
+
+def get_script_version() -> str:
+    """
+    Hash of all scripts in springbootplusplus-web_core, so changing the generator
+    invalidates every cached result.
+
+    Returns:
+        Hex digest identifying the current script version
+    """
+    global _script_version
+    if _script_version is None:
+        script_dir = Path(os.path.dirname(os.path.abspath(__file__)))
+        digest = hashlib.sha256()
+        for script in sorted(script_dir.glob("*.py")):
+            digest.update(script.name.encode('utf-8'))
+            digest.update(script.read_bytes())
+        _script_version = digest.hexdigest()
+    return _script_version
+
+
+def hash_file(file_path: str) -> Optional[str]:
+    """
+    SHA-256 of a file's content.
+
+    Args:
+        file_path: Path to the file
+
+    Returns:
+        Hex digest, or None if the file cannot be read
+    """
+    try:
+        with open(file_path, 'rb') as file:
+            return hashlib.sha256(file.read()).hexdigest()
+    except Exception:
+        return None
+
+
+class CodegenCache:
+    """
+    Content-hash keyed cache of per-file codegen results, persisted as JSON.
+    """
+
+    def __init__(self, cache_file: str = DEFAULT_CACHE_FILE):
+        self.cache_file = cache_file
+        self.version = get_script_version()
+        self.entries = {}
+        self.dirty = False
+        self.hits = 0
+        self.misses = 0
+        self.load()
+
+    def load(self):
+        """Load the cache file; a missing, corrupt or outdated cache starts empty."""
+        try:
+            with open(self.cache_file, 'r', encoding='utf-8') as file:
+                data = json.load(file)
+            if data.get('version') == self.version:
+                self.entries = data.get('files', {})
+        except Exception:
+            self.entries = {}
+
+    def save(self):
+        """Write the cache file if anything changed (atomically, via a temporary file)."""
+        if not self.dirty:
+            return
+        try:
+            cache_dir = os.path.dirname(os.path.abspath(self.cache_file))
+            os.makedirs(cache_dir, exist_ok=True)
+            temp_file = self.cache_file + ".tmp"
+            with open(temp_file, 'w', encoding='utf-8') as file:
+                json.dump({'version': self.version, 'files': self.entries}, file, indent=1, sort_keys=True)
+            os.replace(temp_file, self.cache_file)
+            self.dirty = False
+        except Exception as e:
+            # print(f"Warning: Could not write codegen cache '{self.cache_file}': {e}")
+            pass
+
+    def lookup(self, file_path: str, content_hash: Optional[str], field: str) -> Tuple[bool, Any]:
+        """
+        Get a cached result for a file.
+
+        Args:
+            file_path: Path to the source file
+            content_hash: Current hash of the file (hash_file)
+            field: Result name, e.g. 'endpoints' or 'bean'
+
+        Returns:
+            Tuple of (hit, value)
+        """
+        entry = self.entries.get(self._key(file_path))
+        if content_hash is not None and entry and entry.get('hash') == content_hash and field in entry.get('fields', {}):
+            self.hits += 1
+            return True, entry['fields'][field]
+        self.misses += 1
+        return False, None
+
+    def store(self, file_path: str, content_hash: Optional[str], field: str, value: Any):
+        """
+        Store a result for a file. Results stored for an older content hash are dropped.
+
+        Args:
+            file_path: Path to the source file
+            content_hash: Hash of the content the result was computed from
+            field: Result name
+            value: JSON-serializable result
+        """
+        if content_hash is None:
+            return
+        key = self._key(file_path)
+        entry = self.entries.get(key)
+        if not entry or entry.get('hash') != content_hash:
+            entry = {'hash': content_hash, 'fields': {}}
+            self.entries[key] = entry
+        if field not in entry['fields'] or entry['fields'][field] != value:
+            entry['fields'][field] = value
+            self.dirty = True
+
+    def advance(self, file_path: str, old_hash: Optional[str], new_hash: Optional[str]):
+        """
+        Keep a file's results after the pipeline itself rewrote the file.
+
+        Args:
+            file_path: Path to the source file
+            old_hash: Hash before the rewrite
+            new_hash: Hash after the rewrite
+        """
+        entry = self.entries.get(self._key(file_path))
+        if entry and old_hash is not None and new_hash is not None and entry.get('hash') == old_hash and old_hash != new_hash:
+            entry['hash'] = new_hash
+            self.dirty = True
+
+    def prune(self, file_paths: List[str]):
+        """
+        Drop entries of files that no longer exist in the scanned set.
+
+        Args:
+            file_paths: All files found by the current run
+        """
+        keep = {self._key(file_path) for file_path in file_paths}
+        for key in list(self.entries.keys()):
+            if key not in keep:
+                del self.entries[key]
+                self.dirty = True
+
+    @staticmethod
+    def _key(file_path: str) -> str:
+        return str(Path(file_path).resolve())
+
+
+def write_if_changed(file_path: str, content: str) -> bool:
+    """
+    Write a generated file only if its content differs, so unchanged outputs keep
+    their timestamps and do not trigger recompilation.
+
+    Args:
+        file_path: Path to the output file
+        content: New file content
+
+    Returns:
+        True if the file was written, False if it was already up to date
+    """
+    try:
+        with open(file_path, 'r', encoding='utf-8') as file:
+            if file.read() == content:
+                return False
+    except FileNotFoundError:
+        pass
+    with open(file_path, 'w', encoding='utf-8') as file:
+        file.write(content)
+    return True
+
+
+def main():
+    """Main function to inspect or clear the cache from the command line."""
+    parser = argparse.ArgumentParser(
+        description="Inspect or clear the springbootplusplus-web codegen cache"
+    )
+    parser.add_argument(
+        "--cache-file",
+        default=DEFAULT_CACHE_FILE,
+        help=f"Path to the cache file (default: {DEFAULT_CACHE_FILE})"
+    )
+    parser.add_argument(
+        "--clear",
+        action="store_true",
+        help="Delete the cache file"
+    )
+
+    args = parser.parse_args()
+
+    if args.clear:
+        if os.path.exists(args.cache_file):
+            os.remove(args.cache_file)
+        return {}
+
+    cache = CodegenCache(args.cache_file)
+    # print(f"Script version: {cache.version}")
+    # print(f"Cached files: {len(cache.entries)}")
+    return cache.entries
+
+
+# Export functions for other scripts to import
+__all__ = [
+    'DEFAULT_CACHE_FILE',
+    'CodegenCache',
+    'get_script_version',
+    'hash_file',
+    'write_if_changed',
+    'main'
+]
+
+
+if __name__ == "__main__":
+    main()
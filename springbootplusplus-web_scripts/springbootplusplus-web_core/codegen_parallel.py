@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""
+Parallel helpers for the code generation pipeline.
+
+Per-file analysis is independent, so the stages fan it out over all cores with
+multiprocessing and merge the results in input order. The merge never depends on
+which worker finished first, so the output is byte-identical to a serial run
+(--jobs 1).
+
+Stages that rewrite sources in parallel write through write_file_atomic(), so a
+worker scanning the tree for a class declaration never reads a half-written file,
+and group files that rewrite each other (a component and its interface header)
+with group_related_files() so those writes keep their serial order.
+"""
+
+import os
+import argparse
+import multiprocessing
+import multiprocessing.pool
+from typing import Callable, Dict, Iterable, List, Optional, TypeVar
+import source_index
+
+
+T = TypeVar('T')
+R = TypeVar('R')
+
+
+def default_jobs() -> int:
+    """
+    Number of worker processes used when --jobs is not given.
+
+    Returns:
+        Number of CPUs (at least 1)
+    """
+    return max(1, os.cpu_count() or 1)
+
+
+def resolve_jobs(jobs: Optional[int], item_count: int) -> int:
+    """
+    Effective number of workers for a batch.
+
+    Args:
+        jobs: Requested workers (None or 0 for all cores)
+        item_count: Number of items in the batch
+
+    Returns:
+        Number of workers, never more than the number of items
+    """
+    if not jobs or jobs < 1:
+        jobs = default_jobs()
+    return max(1, min(jobs, item_count))
+
+
+def parallel_map(function: Callable[[T], R], items: List[T], jobs: Optional[int] = None, threads: bool = False) -> List[R]:
+    """
+    Apply a function to every item, in parallel, keeping the input order.
+
+    Args:
+        function: Top-level (picklable) function of one argument
+        items: Items to process
+        jobs: Number of workers (None or 0 for all cores, 1 for serial)
+        threads: Use a thread pool instead of processes (for work that waits on
+                 subprocesses and needs no extra interpreter)
+
+    Returns:
+        Results in the order of items
+    """
+    items = list(items)
+    workers = resolve_jobs(jobs, len(items))
+    if workers == 1:
+        return [function(item) for item in items]
+
+    pool_class = multiprocessing.pool.ThreadPool if threads else multiprocessing.Pool
+    with pool_class(workers) as pool:
+        # Small chunks keep the cores busy when a few files are much larger than the rest
+        chunk_size = max(1, len(items) // (workers * 4))
+        return pool.map(function, items, chunksize=chunk_size)
+
+
+def group_related_files(files: List[str], keys_of: Callable[[str], Iterable[str]]) -> List[List[str]]:
+    """
+    Split files into groups that can be processed independently.
+    Files sharing any key (e.g. a class name they declare or implement) end up in
+    the same group. Groups keep the input order of their files and are ordered by
+    their first file.
+
+    Args:
+        files: File paths, in processing order
+        keys_of: Returns the keys of a file
+
+    Returns:
+        List of file groups
+    """
+    parent = list(range(len(files)))
+
+    def find(index: int) -> int:
+        while parent[index] != index:
+            parent[index] = parent[parent[index]]
+            index = parent[index]
+        return index
+
+    owner_by_key: Dict[str, int] = {}
+    for index, file_path in enumerate(files):
+        for key in keys_of(file_path):
+            if key in owner_by_key:
+                root, other = find(index), find(owner_by_key[key])
+                if root != other:
+                    parent[max(root, other)] = min(root, other)
+            else:
+                owner_by_key[key] = index
+
+    groups: Dict[int, List[str]] = {}
+    for index, file_path in enumerate(files):
+        groups.setdefault(find(index), []).append(file_path)
+    return [groups[root] for root in sorted(groups)]
+
+
+def write_file_atomic(file_path: str, content: str):
+    """
+    Replace a file's content atomically (temporary file + rename), so concurrent
+    readers see either the old or the new content. Also drops the file from the
+    source index.
+
+    Args:
+        file_path: Path to the file
+        content: New file content
+    """
+    temp_file = f"{file_path}.{os.getpid()}.tmp"
+    try:
+        with open(temp_file, 'w', encoding='utf-8') as file:
+            file.write(content)
+        try:
+            os.chmod(temp_file, os.stat(file_path).st_mode & 0o7777)
+        except FileNotFoundError:
+            pass
+        os.replace(temp_file, file_path)
+        source_index.invalidate(file_path)
+    finally:
+        if os.path.exists(temp_file):
+            os.remove(temp_file)
+
+
+def main():
+    """Main function to show the default worker count."""
+    parser = argparse.ArgumentParser(
+        description="Show how many workers the codegen pipeline uses by default"
+    )
+    parser.parse_args()
+
+    jobs = default_jobs()
+    # print(f"Default jobs: {jobs}")
+    return jobs
+
+
+# Export functions for other scripts to import
+__all__ = [
+    'default_jobs',
+    'resolve_jobs',
+    'parallel_map',
+    'group_related_files',
+    'write_file_atomic',
+    'main'
+]
+
+
+if __name__ == "__main__":
+    main()
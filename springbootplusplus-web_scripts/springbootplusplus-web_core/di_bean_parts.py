@@ -0,0 +1,390 @@
+#!/usr/bin/env python3
+"""
+Generated bean parts for --generated-dir builds.
+
+In place, the DI stage writes GetInstance(), the Implementation<> specializations and
+the @Autowired initializers into the component sources. With a generated directory the
+sources are left as they are; each component gets one header in that directory,
+<file stem>.beans.h, with only its own bean code:
+- the Implementation<Interface> specializations (the class is forward declared);
+- SPRINGBOOTPLUSPLUS_GENERATED_BEAN_<Class>, what GeneratedBean(<Class>) expands to in
+  the class body: GetInstance() for the bean's scope, which passes the arguments of an
+  @Autowired constructor and fills the @Autowired fields after construction;
+- the includes that code needs (BeanScopes.h, the validator header, the implementation
+  headers of the injected beans).
+
+The component includes its part after its other includes and names it in its class
+(see GeneratedBean.h). A component missing either line is reported at its class
+declaration. Parts are written only when their content changes, so a component edit
+recompiles only the files that include that component.
+"""
+
+import os
+import re
+import sys
+import argparse
+from pathlib import Path
+from typing import Dict, List, Optional, Tuple
+
+import codegen_cache
+import source_index
+from codegen_parallel import write_file_atomic
+import L1_check_component_macro
+import L1_get_validator_name
+import L2_get_file_scope
+import L2_include_validator_header
+from find_interface_names import find_interface_names
+from L4_process_autowired import find_autowired_macros, find_autowired_constructor
+
+
+PART_SUFFIX = ".beans.h"
+
+HEADER_EXTENSIONS = {'.h', '.hpp', '.hh', '.hxx'}
+
+
+def part_file_name(file_path: str) -> str:
+    """
+    Name of a component's generated part, as the component includes it.
+
+    Args:
+        file_path: Component source file
+
+    Returns:
+        File name, e.g. UserService.beans.h for src/UserService.h
+    """
+    return Path(file_path).stem + PART_SUFFIX
+
+
+def part_include_pattern(file_path: str) -> re.Pattern:
+    """Pattern of the line including a component's part (#include "UserService.beans.h")."""
+    return re.compile(r'^\s*#\s*include\s*[<"]([^>"]*/)?' + re.escape(part_file_name(file_path)) + r'[>"]')
+
+
+def bean_macro_pattern(class_name: str) -> re.Pattern:
+    """Pattern of the GeneratedBean(<Class>) line in a component's class body."""
+    return re.compile(r'^\s*GeneratedBean\s*\(\s*' + re.escape(class_name) + r'\s*\)')
+
+
+def describe_component(file_path: str, include_paths: List[str], exclude_paths: List[str]) -> Optional[Dict[str, any]]:
+    """
+    Collect what a component's part is generated from.
+
+    Args:
+        file_path: C++ file
+        include_paths: Scanned include paths (validator header lookup)
+        exclude_paths: Excluded paths
+
+    Returns:
+        Dictionary with 'file_path', 'class_name', 'class_line', 'interface_name', 'scope',
+        'validator_name', 'validator_header', 'fields' ([(name, interface)]) and
+        'constructor_arguments' ([interface]), or None if the file declares no component
+    """
+    if not L1_check_component_macro.check_component_macro_exists(file_path):
+        return None
+    source = source_index.get_source(file_path)
+    interface_names = find_interface_names(file_path)
+    if source is None or not source.classes or not interface_names:
+        return None
+
+    declaration = source.classes[0]
+    scope = L2_get_file_scope.get_file_scope(file_path)
+    validator_name = None
+    validator_header = None
+    if scope.endswith('_VALIDATOR'):
+        validator_name = L1_get_validator_name.get_validator_name(file_path)
+        validator_header = L2_include_validator_header.find_validator_header_path(
+            validator_name, ".", include_paths, exclude_paths)
+
+    constructor = find_autowired_constructor(file_path, declaration.name)
+    return {
+        'file_path': file_path,
+        'class_name': declaration.name,
+        'class_line': declaration.line_number,
+        'interface_name': interface_names[0],
+        'scope': scope,
+        'validator_name': validator_name,
+        'validator_header': validator_header,
+        'fields': [(field['object_name'], field['variable_base_type']) for field in find_autowired_macros(file_path)],
+        'constructor_arguments': [parameter['base_type'] for parameter in constructor['constructor_info']['parameters']]
+                                 if constructor else []
+    }
+
+
+def generate_bean_macro(component: Dict[str, any]) -> List[str]:
+    """
+    Lines of the class body part (the SPRINGBOOTPLUSPLUS_GENERATED_BEAN_<Class> macro).
+
+    Args:
+        component: Component description (describe_component)
+
+    Returns:
+        Macro lines, without the line continuations
+    """
+    class_name = component['class_name']
+    interface_name = component['interface_name']
+    interface_ptr_type = f"{interface_name}Ptr"
+    validator_name = component['validator_name']
+    base_scope = component['scope'].split('_')[0]
+    bean_type = f"{validator_name}<{class_name}>" if validator_name else class_name
+    arguments = ", ".join(f"AutowiredBean<{argument}>()"
+                          for argument in component['constructor_arguments'])
+
+    def create(new_expression: str) -> str:
+        return f"Autowire({new_expression})" if component['fields'] else new_expression
+
+    lines = []
+    if validator_name:
+        lines.append(f"    Public friend class {bean_type};")
+    lines.append(f"    Public Static {interface_ptr_type} GetInstance() {{")
+    if base_scope == "SINGLETON":
+        lines.append(f"        static {interface_ptr_type} instance({create(f'new {bean_type}({arguments})')});")
+        lines.append("        return instance;")
+    elif base_scope == "PROTOTYPE":
+        lines.append(f"        {interface_ptr_type} instance({create(f'new {bean_type}({arguments})')});")
+        lines.append("        return instance;")
+    elif base_scope == "REQUEST":
+        lines.append(f"        return RequestScope::GetInstance<{bean_type}, {interface_name}>("
+                     f"[](void* storage) -> {bean_type}* {{ return {create(f'new (storage) {bean_type}({arguments})')}; }});")
+    elif base_scope == "POOLED":
+        lines.append(f"        return BeanPool<{bean_type}, {interface_name}>::Instance().Acquire("
+                     f"[]() -> {bean_type}* {{ return {create(f'new {bean_type}({arguments})')}; }});")
+    else:
+        raise ValueError(f"Unknown scope: {component['scope']}")
+    lines.append("    }")
+
+    if component['fields']:
+        lines.append("    Private template<typename Bean> Static Bean* Autowire(Bean* bean) {")
+        lines.append(f"        {class_name}* target = bean;")
+        for field_name, field_interface in component['fields']:
+            lines.append(f"        target->{field_name} = AutowiredBean<{field_interface}>();")
+        lines.append("        return bean;")
+        lines.append("    }")
+    lines.append("    Private")
+    return lines
+
+
+def generate_part(component: Dict[str, any], implementations: Dict[str, str],
+                  rejected: List[Tuple[int, str]]) -> str:
+    """
+    Content of a component's generated part.
+
+    Args:
+        component: Component description (describe_component)
+        implementations: Interface name -> header of the component implementing it
+        rejected: Injections of this file the DI stage rejected, as (line, message); each
+                  becomes an #error at that line of the component
+
+    Returns:
+        File content
+    """
+    file_path = Path(component['file_path']).resolve()
+    class_name = component['class_name']
+    interface_name = component['interface_name']
+    guard = re.sub(r'[^A-Za-z0-9]', '_', file_path.stem).upper() + "_BEANS_H"
+    singleton = "true" if component['scope'].split('_')[0] == "SINGLETON" else "false"
+
+    lines = [
+        f"// Generated by springbootplusplus-web pre-build from {file_path.as_posix()}. Do not edit.\n",
+        f"#ifndef {guard}\n",
+        f"#define {guard}\n",
+        "\n",
+    ]
+    for line_number, message in rejected:
+        escaped = message.replace('\\', '\\\\').replace('"', '\\"')
+        lines.append(f'#line {line_number} "{file_path.as_posix()}"\n')
+        lines.append(f'#error "{escaped}"\n')
+
+    # The binding comes before the includes: a header included from here may reach this
+    # component again (e.g. through the dispatcher) and must find its Implementation<>
+    lines.extend([
+        "#include <GeneratedBean.h>\n",
+        "\n",
+        f"class {class_name};\n",
+        "\n",
+        "template <>\n",
+        f"struct Implementation<{interface_name}> {{\n",
+        f"    using type = {class_name};\n",
+        f"    static constexpr bool singleton = {singleton};\n",
+        "};\n",
+        "\n",
+        "template <>\n",
+        f"struct Implementation<{interface_name}*> {{\n",
+        f"    using type = {class_name}*;\n",
+        "};\n",
+        "\n",
+    ])
+
+    includes = []
+    if component['scope'].split('_')[0] in ("REQUEST", "POOLED"):
+        includes.append("<BeanScopes.h>")
+    if component['validator_header']:
+        includes.append(f'"{Path(component["validator_header"]).resolve().as_posix()}"')
+    dependencies = [interface for _, interface in component['fields']] + component['constructor_arguments']
+    for dependency in dependencies:
+        header = implementations.get(dependency)
+        if header and Path(header).resolve() != file_path:
+            include = f'"{Path(header).resolve().as_posix()}"'
+            if include not in includes:
+                includes.append(include)
+    lines.extend(f"#include {include}\n" for include in includes)
+    if includes:
+        lines.append("\n")
+
+    lines.extend([
+        f"// Expanded by GeneratedBean({class_name}) in the class body\n",
+        f"#define SPRINGBOOTPLUSPLUS_GENERATED_BEAN_{class_name} \\\n",
+    ])
+    macro_lines = generate_bean_macro(component)
+    lines.extend(line + " \\\n" for line in macro_lines[:-1])
+    lines.append(macro_lines[-1] + "\n")
+    lines.extend(["\n", f"#endif // {guard}\n"])
+    return ''.join(lines)
+
+
+def check_part_lines(component: Dict[str, any]) -> List[str]:
+    """
+    Check that a component includes its part and names it in the class body.
+
+    Args:
+        component: Component description (describe_component)
+
+    Returns:
+        Error messages, as file:line: error: ...
+    """
+    file_path = component['file_path']
+    lines = source_index.load(file_path).lines
+    errors = []
+    if not any(part_include_pattern(file_path).match(line) for line in lines):
+        errors.append(f'{file_path}:{component["class_line"]}: error: component {component["class_name"]} must '
+                      f'#include "{part_file_name(file_path)}" (generated bean code) after its other includes')
+    if not any(bean_macro_pattern(component['class_name']).match(line) for line in lines):
+        errors.append(f'{file_path}:{component["class_line"]}: error: component {component["class_name"]} must '
+                      f'start its class body with GeneratedBean({component["class_name"]})')
+    return errors
+
+
+def write_bean_parts(cpp_files: List[str], include_paths: List[str], exclude_paths: List[str], generated_dir: str,
+                     rejected: Optional[List[Tuple[str, int, str]]] = None) -> Tuple[List[str], List[str]]:
+    """
+    Write the generated part of every component and remove parts of former components.
+
+    Args:
+        cpp_files: Scanned C++ files
+        include_paths: Scanned include paths
+        exclude_paths: Excluded paths
+        generated_dir: Generated directory (on the include path of the build)
+        rejected: Injections the DI stage rejected, as (file path, line, message)
+
+    Returns:
+        Tuple of (parts written or removed, errors)
+    """
+    components = [component for component in
+                  (describe_component(file_path, include_paths, exclude_paths) for file_path in cpp_files)
+                  if component]
+    implementations = {component['interface_name']: component['file_path'] for component in components
+                       if Path(component['file_path']).suffix.lower() in HEADER_EXTENSIONS}
+
+    errors = []
+    parts = {}
+    for component in components:
+        name = part_file_name(component['file_path'])
+        if name in parts:
+            errors.append(f"{component['file_path']}:{component['class_line']}: error: generated bean header "
+                          f"{name} is also used by {parts[name]['file_path']}; rename one of the files")
+            continue
+        parts[name] = component
+        errors.extend(check_part_lines(component))
+
+    rejected_by_file = {}
+    for file_path, line_number, message in rejected or []:
+        rejected_by_file.setdefault(str(Path(file_path).resolve()), []).append((line_number, message))
+
+    os.makedirs(generated_dir, exist_ok=True)
+    changed = []
+    for name, component in parts.items():
+        content = generate_part(component, implementations,
+                                rejected_by_file.get(str(Path(component['file_path']).resolve()), []))
+        output = os.path.join(generated_dir, name)
+        if codegen_cache.write_if_changed(output, content):
+            changed.append(output)
+
+    # Parts of files that are no longer components
+    for name in os.listdir(generated_dir):
+        if name.endswith(PART_SUFFIX) and name not in parts:
+            os.remove(os.path.join(generated_dir, name))
+            changed.append(os.path.join(generated_dir, name))
+
+    return changed, errors
+
+
+def comment_bean_part_lines(file_path: str, dry_run: bool = False) -> bool:
+    """
+    Comment out the part include and GeneratedBean(<Class>) of a component processed in
+    place, where the bean code is written into the class instead.
+
+    Args:
+        file_path: Component file
+        dry_run: If True, do not modify the file
+
+    Returns:
+        True if a line was (or would be) commented out
+    """
+    source = source_index.load(file_path)
+    include_pattern = part_include_pattern(file_path)
+    macro_patterns = [bean_macro_pattern(class_name) for class_name in source.class_names]
+    lines = list(source.lines)
+    changed = False
+    for index, line in enumerate(lines):
+        if include_pattern.match(line) or any(pattern.match(line) for pattern in macro_patterns):
+            indent = line[:len(line) - len(line.lstrip())]
+            lines[index] = f"{indent}// {line.strip()}\n"
+            changed = True
+    if changed and not dry_run:
+        write_file_atomic(file_path, ''.join(lines))
+    return changed
+
+
+def main():
+    """Main function to write the generated bean parts of a set of files."""
+    parser = argparse.ArgumentParser(
+        description="Write the generated bean headers (<file>.beans.h) of a --generated-dir build"
+    )
+    parser.add_argument(
+        "files",
+        nargs="+",
+        help="All C++ files of the build (parts of other files are removed)"
+    )
+    parser.add_argument(
+        "--include",
+        nargs="+",
+        default=[],
+        help="Include paths that were scanned"
+    )
+    parser.add_argument(
+        "--generated-dir",
+        required=True,
+        help="Generated directory of the build"
+    )
+
+    args = parser.parse_args()
+
+    changed, errors = write_bean_parts(args.files, args.include, [], args.generated_dir)
+    for error in errors:
+        print(error, file=sys.stderr)
+    sys.exit(1 if errors else 0)
+
+
+# Export functions for other scripts to import
+__all__ = [
+    'PART_SUFFIX',
+    'part_file_name',
+    'describe_component',
+    'generate_part',
+    'write_bean_parts',
+    'comment_bean_part_lines',
+    'main'
+]
+
+
+if __name__ == "__main__":
+    main()
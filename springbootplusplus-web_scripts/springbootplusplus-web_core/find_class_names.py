@@ -8,6 +8,7 @@ import re
 import argparse
 from pathlib import Path
 from typing import List, Optional, Tuple
+import source_index
 
 
 def find_class_names(file_path: str) -> List[str]:
@@ -20,11 +21,8 @@ def find_class_names(file_path: str) -> List[str]:
     Returns:
         List of class names found in the file
     """
-    class_names = []
-    
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            content = file.read()
+        source = source_index.load(file_path)
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return []
@@ -32,26 +30,8 @@ def find_class_names(file_path: str) -> List[str]:
         # print(f"Error reading file '{file_path}': {e}")
         return []
     
-    # Enhanced pattern to match class declarations including final, template, etc.
-    # Matches various class declaration patterns:
-    # - class ClassName
-    # - class ClassName : public BaseClass
-    # - class ClassName final : public BaseClass
-    # - template<typename T> class ClassName
-    # - template<typename T> class ClassName final : public BaseClass
-    # - class ClassName final
-    # - class ClassName : public Base, public AnotherBase
-    class_pattern = r'(?:template\s*<[^>]*>\s*)?class\s+([A-Za-z_][A-Za-z0-9_]*)\s*(?:final\s+)?(?:[:<][^;{]*)?\s*{'
-    
-    # Find all matches
-    matches = re.finditer(class_pattern, content, re.MULTILINE | re.DOTALL)
-    
-    for match in matches:
-        class_name = match.group(1)
-        if class_name not in class_names:
-            class_names.append(class_name)
-    
-    return class_names
+    # Class declarations are indexed once per file (see source_index.class_declaration_pattern)
+    return list(source.class_names)
 
 
 def find_class_names_in_files(file_paths: List[str]) -> dict:
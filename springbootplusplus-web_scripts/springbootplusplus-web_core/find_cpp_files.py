@@ -8,8 +8,10 @@ import os
 import argparse
 from pathlib import Path
 from typing import List, Set, Optional
+import source_index
 
 
+@source_index.cached_listing
 def find_cpp_files(
     root_dir: str = ".",
     include_folders: Optional[List[str]] = None,
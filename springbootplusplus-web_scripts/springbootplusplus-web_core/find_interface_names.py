@@ -8,6 +8,7 @@ import re
 import argparse
 from pathlib import Path
 from typing import List, Dict, Optional, Tuple
+import source_index
 
 
 def find_interface_names(file_path: str) -> List[str]:
@@ -20,11 +21,8 @@ def find_interface_names(file_path: str) -> List[str]:
     Returns:
         List of interface names found in the file
     """
-    interface_names = []
-    
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            content = file.read()
+        source = source_index.load(file_path)
     except FileNotFoundError:
         print(f"Error: File '{file_path}' not found")
         return []
@@ -32,30 +30,8 @@ def find_interface_names(file_path: str) -> List[str]:
         print(f"Error reading file '{file_path}': {e}")
         return []
     
-    # Pattern to match class inheritance declarations
-    # Matches various inheritance patterns:
-    # - class ClassName : public InterfaceName
-    # - class ClassName final : public InterfaceName
-    # - class ClassName : protected InterfaceName
-    # - class ClassName : private InterfaceName
-    # - class ClassName : public InterfaceName<Template>
-    # - class ClassName : public InterfaceName, public AnotherInterface
-    # - class ClassName : virtual public InterfaceName
-    inheritance_pattern = r'class\s+[A-Za-z_][A-Za-z0-9_]*\s*(?:final\s+)?:\s*(?:virtual\s+)?(?:public|protected|private)\s+([A-Za-z_][A-Za-z0-9_]*)(?:<[^>]*>)?(?:\s*,\s*(?:virtual\s+)?(?:public|protected|private)\s+([A-Za-z_][A-Za-z0-9_]*)(?:<[^>]*>)?)*'
-    
-    # Find all matches
-    matches = re.finditer(inheritance_pattern, content, re.MULTILINE | re.DOTALL)
-    
-    for match in matches:
-        # Extract all interface names from the match
-        for group in match.groups():
-            if group:
-                # Clean up the interface name (remove extra whitespace, etc.)
-                interface_name = group.strip()
-                if interface_name and interface_name not in interface_names:
-                    interface_names.append(interface_name)
-    
-    return interface_names
+    # Inheritance declarations are indexed once per file (see source_index.inheritance_pattern)
+    return list(source.interface_names)
 
 
 def find_interface_names_in_files(file_paths: List[str]) -> Dict[str, List[str]]:
@@ -78,6 +54,7 @@ def find_interface_names_in_files(file_paths: List[str]) -> Dict[str, List[str]]
     return results
 
 
+@source_index.cached_query
 def find_class_inheritance_details(file_path: str) -> List[Dict[str, str]]:
     """
     Find detailed class inheritance information including class names and their interfaces.
@@ -91,8 +68,7 @@ def find_class_inheritance_details(file_path: str) -> List[Dict[str, str]]:
     inheritance_details = []
     
     try:
-        with open(file_path, 'r', encoding='utf-8') as file:
-            content = file.read()
+        content = source_index.load(file_path).content
     except FileNotFoundError:
         # print(f"Error: File '{file_path}' not found")
         return []
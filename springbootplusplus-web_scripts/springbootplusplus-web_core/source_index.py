@@ -0,0 +1,468 @@
+#!/usr/bin/env python3
+"""
+Source index shared by all code generation stages.
+
+Every stage used to reopen and re-regex the same files on its own. This module reads
+each file once, indexes it in a single pass and keeps the result for the lifetime of
+the process:
+- annotations (/* @X(...) */, processed or not) with their line numbers
+- annotated declarations (classes, methods, fields) with the annotations above them
+- class declarations, class names and implemented interface names
+
+Stages query the index with get_source(file_path) instead of opening the file, and
+per-file parse functions are memoized on the indexed file with @cached_query, so a
+function asked the same question about the same file content answers from memory.
+Directory walks (@cached_listing) are done once per process.
+
+An entry is reused while the file's inode, size and modification time are unchanged.
+Pipeline rewrites go through codegen_parallel.write_file_atomic(), which replaces the
+inode and drops the entry, so no stage ever sees stale content.
+"""
+
+import copy
+import functools
+import os
+import re
+import argparse
+from typing import Any, Callable, Dict, List, Optional, Tuple
+
+
+# Annotation comment, before (/* @X */) and after (/*--@X--*/) processing
+annotation_pattern = re.compile(r'/\*(--)?\s*@([A-Za-z_][A-Za-z0-9_]*)\s*(?:\((.*?)\))?\s*(?:--)?\*/')
+
+# Class declarations (as used by find_class_names):
+# - class ClassName / class ClassName final
+# - class ClassName : public Base, public AnotherBase
+# - template<typename T> class ClassName final : public Base
+class_declaration_pattern = re.compile(r'(?:template\s*<[^>]*>\s*)?class\s+([A-Za-z_][A-Za-z0-9_]*)\s*(?:final\s+)?(?:[:<][^;{]*)?\s*{', re.MULTILINE | re.DOTALL)
+
+# Class inheritance (as used by find_interface_names):
+# - class ClassName [final] : [virtual] public|protected|private Interface[<T>], ...
+inheritance_pattern = re.compile(r'class\s+[A-Za-z_][A-Za-z0-9_]*\s*(?:final\s+)?:\s*(?:virtual\s+)?(?:public|protected|private)\s+([A-Za-z_][A-Za-z0-9_]*)(?:<[^>]*>)?(?:\s*,\s*(?:virtual\s+)?(?:public|protected|private)\s+([A-Za-z_][A-Za-z0-9_]*)(?:<[^>]*>)?)*', re.MULTILINE | re.DOTALL)
+
+base_class_pattern = re.compile(r'(?:virtual\s+)?(?:(?:public|protected|private)\s+)?(?:virtual\s+)?([A-Za-z_][A-Za-z0-9_:]*)')
+identifier_pattern = re.compile(r'[A-Za-z_][A-Za-z0-9_]*')
+
+# Lines scanned after an annotation for the declaration it belongs to
+MAX_DECLARATION_LINES = 20
+
+
+class Annotation:
+    """An annotation comment, e.g. /* @GetMapping("/{id}") */ on line 14."""
+
+    def __init__(self, name: str, arguments: Optional[str], line_number: int, processed: bool, text: str):
+        self.name = name
+        self.arguments = arguments
+        self.line_number = line_number
+        self.processed = processed
+        self.text = text
+
+    def __repr__(self):
+        return f"Annotation({self.text!r}, line {self.line_number})"
+
+
+class Declaration:
+    """
+    A declaration that follows one or more annotations.
+    kind is 'class', 'method' or 'field'; text is the declaration up to its ';' or '{'.
+    """
+
+    def __init__(self, kind: str, name: str, line_number: int, text: str, annotations: List[Annotation]):
+        self.kind = kind
+        self.name = name
+        self.line_number = line_number
+        self.text = text
+        self.annotations = annotations
+
+    def has_annotation(self, name: str) -> bool:
+        return any(annotation.name == name for annotation in self.annotations)
+
+    def __repr__(self):
+        return f"Declaration({self.kind} {self.name}, line {self.line_number})"
+
+
+class ClassDeclaration:
+    """A class declaration with its base classes."""
+
+    def __init__(self, name: str, line_number: int, bases: List[str], is_final: bool, is_template: bool):
+        self.name = name
+        self.line_number = line_number
+        self.bases = bases
+        self.is_final = is_final
+        self.is_template = is_template
+
+    def __repr__(self):
+        return f"ClassDeclaration({self.name}, line {self.line_number})"
+
+
+class SourceFile:
+    """
+    One indexed source file. Built by load(); do not modify its attributes.
+    """
+
+    def __init__(self, file_path: str, content: str, stamp: Tuple[int, int, int]):
+        self.file_path = file_path
+        self.content = content
+        self.stamp = stamp
+        self.queries: Dict[Any, Any] = {}
+
+        # Same split as file.readlines()
+        parts = content.split('\n')
+        self._lines = [part + '\n' for part in parts[:-1]]
+        if parts[-1]:
+            self._lines.append(parts[-1])
+        self.stripped_lines = [line.strip() for line in self._lines]
+
+        self._annotations: Optional[List[Annotation]] = None
+        self._declarations: Optional[List[Declaration]] = None
+
+    # The model is built on first use, so a stage that only needs the lines pays for nothing else
+
+    @property
+    def annotations(self) -> List[Annotation]:
+        if self._annotations is None:
+            self._index()
+        return self._annotations
+
+    @property
+    def declarations(self) -> List[Declaration]:
+        if self._declarations is None:
+            self._index()
+        return self._declarations
+
+    @functools.cached_property
+    def classes(self) -> List[ClassDeclaration]:
+        return self._find_classes()
+
+    @functools.cached_property
+    def class_names(self) -> List[str]:
+        return self._unique(declaration.name for declaration in self.classes)
+
+    @functools.cached_property
+    def interface_names(self) -> List[str]:
+        return self._find_interface_names()
+
+    @property
+    def lines(self) -> List[str]:
+        """The file's lines (with line endings), as a new list the caller may modify."""
+        return list(self._lines)
+
+    @property
+    def methods(self) -> List[Declaration]:
+        return [declaration for declaration in self.declarations if declaration.kind == 'method']
+
+    @property
+    def fields(self) -> List[Declaration]:
+        return [declaration for declaration in self.declarations if declaration.kind == 'field']
+
+    def annotations_named(self, name: str, processed: Optional[bool] = None) -> List[Annotation]:
+        """
+        Annotations with the given name.
+
+        Args:
+            name: Annotation name without '@', e.g. 'Scope'
+            processed: True/False to only return processed/unprocessed ones, None for both
+        """
+        return [
+            annotation for annotation in self.annotations
+            if annotation.name == name and (processed is None or annotation.processed == processed)
+        ]
+
+    def has_annotation(self, name: str, processed: Optional[bool] = None) -> bool:
+        return bool(self.annotations_named(name, processed))
+
+    def _index(self):
+        """Single pass over the lines: collect annotations and the declarations they annotate."""
+        self._annotations = []
+        self._declarations = []
+        pending: List[Annotation] = []
+        line_index = 0
+        while line_index < len(self._lines):
+            stripped_line = self.stripped_lines[line_index]
+            line_number = line_index + 1
+            self._annotations.extend(self._annotations_in(stripped_line, line_number))
+
+            if not stripped_line or stripped_line.startswith('//'):
+                line_index += 1
+                continue
+
+            # Annotations in front of the code on this line
+            leading = []
+            position = 0
+            match = annotation_pattern.match(stripped_line)
+            while match:
+                leading.extend(self._annotations_in(match.group(0), line_number))
+                position = len(stripped_line) - len(stripped_line[match.end():].lstrip())
+                match = annotation_pattern.match(stripped_line, position)
+            remainder = stripped_line[position:]
+
+            if not remainder:
+                # Annotation-only line: belongs to the next declaration
+                pending.extend(leading)
+                line_index += 1
+                continue
+
+            if pending or leading:
+                text, last_index = self._collect_declaration(line_index, remainder)
+                self._declarations.append(self._make_declaration(text, line_number, pending + leading))
+                # Parameter annotations inside a multi-line declaration
+                for next_index in range(line_index + 1, last_index + 1):
+                    self._annotations.extend(self._annotations_in(self.stripped_lines[next_index], next_index + 1))
+                pending = []
+                line_index = last_index + 1
+                continue
+
+            line_index += 1
+
+    @staticmethod
+    def _annotations_in(text: str, line_number: int) -> List[Annotation]:
+        return [
+            Annotation(match.group(2), match.group(3), line_number, match.group(1) == '--', match.group(0))
+            for match in annotation_pattern.finditer(text)
+        ]
+
+    def _collect_declaration(self, start_index: int, first_line: str) -> Tuple[str, int]:
+        """Join the lines of a declaration up to its ';' or '{' (skipping blank and // lines)."""
+        text = first_line
+        last_index = start_index
+        if ';' in first_line or '{' in first_line:
+            return text, last_index
+        for index in range(start_index + 1, min(start_index + MAX_DECLARATION_LINES, len(self._lines))):
+            stripped_line = self.stripped_lines[index]
+            last_index = index
+            if not stripped_line or stripped_line.startswith('//'):
+                continue
+            text += " " + stripped_line
+            if ';' in stripped_line or '{' in stripped_line:
+                break
+        return text, last_index
+
+    @staticmethod
+    def _make_declaration(text: str, line_number: int, annotations: List[Annotation]) -> Declaration:
+        code = annotation_pattern.sub(' ', text)
+        class_match = re.search(r'\b(?:class|struct)\s+([A-Za-z_][A-Za-z0-9_]*)', code)
+        if class_match:
+            return Declaration('class', class_match.group(1), line_number, text, annotations)
+
+        head = re.split(r'[;{]', code, maxsplit=1)[0]
+        paren = head.find('(')
+        equals = head.find('=')
+        if paren >= 0 and (equals < 0 or paren < equals):
+            names = identifier_pattern.findall(head[:paren])
+            return Declaration('method', names[-1] if names else "", line_number, text, annotations)
+
+        names = identifier_pattern.findall(head[:equals] if equals >= 0 else head)
+        return Declaration('field', names[-1] if names else "", line_number, text, annotations)
+
+    def _line_number_at(self, offset: int) -> int:
+        return self.content.count('\n', 0, offset) + 1
+
+    def _find_classes(self) -> List[ClassDeclaration]:
+        classes = []
+        for match in class_declaration_pattern.finditer(self.content):
+            # Everything between the class name and '{': [<...>] [final] [: bases]
+            tail = self.content[match.end(1):match.end()]
+            base_match = re.match(r'\s*(?:<[^>]*>)?\s*(?:final\b)?\s*:(?!:)(.*)\{$', tail, re.DOTALL)
+            bases = []
+            if base_match:
+                for part in self._split_bases(base_match.group(1)):
+                    name_match = base_class_pattern.match(part.strip())
+                    if name_match:
+                        bases.append(name_match.group(1))
+            classes.append(ClassDeclaration(
+                match.group(1),
+                self._line_number_at(match.start(1)),
+                bases,
+                bool(re.match(r'\s*(?:<[^>]*>)?\s*final\b', tail)),
+                match.group(0).startswith('template')
+            ))
+        return classes
+
+    @staticmethod
+    def _split_bases(base_text: str) -> List[str]:
+        parts, depth, current = [], 0, ""
+        for char in base_text:
+            if char == '<':
+                depth += 1
+            elif char == '>':
+                depth -= 1
+            if char == ',' and depth == 0:
+                parts.append(current)
+                current = ""
+            else:
+                current += char
+        if current.strip():
+            parts.append(current)
+        return parts
+
+    def _find_interface_names(self) -> List[str]:
+        interface_names = []
+        for match in inheritance_pattern.finditer(self.content):
+            for group in match.groups():
+                if group:
+                    interface_name = group.strip()
+                    if interface_name and interface_name not in interface_names:
+                        interface_names.append(interface_name)
+        return interface_names
+
+    @staticmethod
+    def _unique(names) -> List[str]:
+        unique_names = []
+        for name in names:
+            if name not in unique_names:
+                unique_names.append(name)
+        return unique_names
+
+
+_sources: Dict[str, SourceFile] = {}
+_listings: Dict[Any, List[str]] = {}
+
+
+def _key(file_path: str) -> str:
+    return os.path.abspath(file_path)
+
+
+def load(file_path: str) -> SourceFile:
+    """
+    Get the indexed file, reading it only if it changed since it was last indexed.
+    Raises the same exceptions as opening the file would (FileNotFoundError, ...).
+
+    Args:
+        file_path: Path to the C++ file
+
+    Returns:
+        SourceFile
+    """
+    stat = os.stat(file_path)
+    stamp = (stat.st_ino, stat.st_size, stat.st_mtime_ns)
+    key = _key(file_path)
+    source = _sources.get(key)
+    if source is not None and source.stamp == stamp:
+        return source
+
+    with open(file_path, 'r', encoding='utf-8') as file:
+        content = file.read()
+    source = SourceFile(file_path, content, stamp)
+    _sources[key] = source
+    return source
+
+
+def get_source(file_path: str) -> Optional[SourceFile]:
+    """
+    Like load(), but returns None if the file cannot be read.
+
+    Args:
+        file_path: Path to the C++ file
+
+    Returns:
+        SourceFile, or None
+    """
+    try:
+        return load(file_path)
+    except Exception:
+        return None
+
+
+def invalidate(file_path: Optional[str] = None):
+    """
+    Drop the index of a file (or of all files and directory listings), e.g. after rewriting it.
+
+    Args:
+        file_path: Path to the file, or None to clear the whole index
+    """
+    if file_path is None:
+        _sources.clear()
+        _listings.clear()
+    else:
+        _sources.pop(_key(file_path), None)
+
+
+def cached_query(function: Callable) -> Callable:
+    """
+    Memoize a per-file parse function on the indexed file.
+    The function's first argument must be the file path; further arguments must be
+    hashable. Callers get their own copy of the result. If the file cannot be read,
+    the function is called as is (keeping its own error handling).
+    """
+    @functools.wraps(function)
+    def wrapper(file_path, *args, **kwargs):
+        source = get_source(file_path)
+        if source is None:
+            return function(file_path, *args, **kwargs)
+        key = (function.__module__, function.__qualname__, args, tuple(sorted(kwargs.items())))
+        try:
+            hash(key)
+        except TypeError:
+            return function(file_path, *args, **kwargs)
+        if key not in source.queries:
+            source.queries[key] = function(file_path, *args, **kwargs)
+        return copy.deepcopy(source.queries[key])
+    return wrapper
+
+
+def cached_listing(function: Callable) -> Callable:
+    """
+    Memoize a directory walk returning a list of files.
+    The pipeline rewrites sources but never adds or removes them, so a tree is walked
+    once per process however many lookups search it. Arguments may be lists.
+    """
+    @functools.wraps(function)
+    def wrapper(*args, **kwargs):
+        def freeze(value):
+            return tuple(value) if isinstance(value, list) else value
+        key = (function.__module__, function.__qualname__, os.getcwd(),
+               tuple(freeze(arg) for arg in args), tuple(sorted((name, freeze(value)) for name, value in kwargs.items())))
+        if key not in _listings:
+            _listings[key] = function(*args, **kwargs)
+        return list(_listings[key])
+    return wrapper
+
+
+def main():
+    """Main function to print the index of C++ files."""
+    parser = argparse.ArgumentParser(
+        description="Show the source index (classes, annotations, declarations) of C++ files"
+    )
+    parser.add_argument(
+        "files",
+        nargs="+",
+        help="C++ source files to index (.cpp, .h, .hpp, etc.)"
+    )
+
+    args = parser.parse_args()
+
+    sources = {}
+    for file_path in args.files:
+        source = get_source(file_path)
+        if source is None:
+            # print(f"Error: Could not read '{file_path}'")
+            continue
+        sources[file_path] = source
+        # print(f"\nFile: {file_path}")
+        # for declaration in source.classes:
+        #     print(f"  class {declaration.name} (line {declaration.line_number}) bases: {', '.join(declaration.bases)}")
+        # for annotation in source.annotations:
+        #     print(f"  {annotation.text} (line {annotation.line_number})")
+        # for declaration in source.declarations:
+        #     print(f"  {declaration.kind} {declaration.name} (line {declaration.line_number})")
+
+    return sources
+
+
+# Export functions for other scripts to import
+__all__ = [
+    'Annotation',
+    'Declaration',
+    'ClassDeclaration',
+    'SourceFile',
+    'load',
+    'get_source',
+    'invalidate',
+    'cached_query',
+    'cached_listing',
+    'main'
+]
+
+
+if __name__ == "__main__":
+    main()
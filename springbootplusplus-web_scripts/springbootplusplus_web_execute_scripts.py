@@ -115,6 +115,21 @@ def execute_scripts(project_dir, library_dir, all_libs=None, library_scripts_dir
             # print(f"⚠️  Warning: HttpRequestDispatcher.h not found at {dispatcher_file}")
             pass
         
+        # Keep the codegen cache in the build directory when the build system provides one
+        cache_file = os.environ.get("SPRINGBOOTPLUSPLUS_WEB_CACHE_FILE")
+        if cache_file:
+            cmd.extend(["--cache-file", cache_file])
+        
+        # Generate the dispatcher code into the build directory instead of rewriting sources
+        generated_dir = os.environ.get("SPRINGBOOTPLUSPLUS_WEB_GENERATED_DIR")
+        if generated_dir:
+            cmd.extend(["--generated-dir", generated_dir])
+        
+        # Worker count for the per-file analysis (default: all cores)
+        jobs = os.environ.get("SPRINGBOOTPLUSPLUS_WEB_JOBS")
+        if jobs:
+            cmd.extend(["--jobs", jobs])
+        
         # print(f"\nRunning: {' '.join(cmd)}")
         # print(f"Include paths: {include_paths}")
         
@@ -325,6 +325,17 @@ if all_libs['scripts_dirs']:
     # print(f"\n📜 DDMM Found {len(all_libs['scripts_dirs'])} library scripts directory(ies)")
     pass
 
+# PlatformIO builds: generated code and the codegen cache go to the build directory as well,
+# so neither the project sources nor this library are rewritten
+if hasattr(env, "Append"):
+    build_dir = env.subst("$BUILD_DIR")
+    generated_dir = os.environ.setdefault("SPRINGBOOTPLUSPLUS_WEB_GENERATED_DIR",
+                                          os.path.join(build_dir, "springbootplusplus-web-generated"))
+    os.environ.setdefault("SPRINGBOOTPLUSPLUS_WEB_CACHE_FILE",
+                          os.path.join(build_dir, "springbootplusplus-web-cache.json"))
+    # Generated dispatcher code and bean headers (<component>.beans.h)
+    env.Append(CPPPATH=[generated_dir])
+
 # Import and execute scripts
 from springbootplusplus_web_execute_scripts import execute_scripts
 execute_scripts(project_dir, library_dir, all_libs, library_scripts_dir)
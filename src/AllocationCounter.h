@@ -0,0 +1,283 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <StandardDefines.h>
+#include <cstdint>
+#include "PipelineStage.h"
+
+/**
+ * Per-stage heap allocation accounting
+ *
+ * Define HTTP_ENABLE_ALLOCATION_COUNTING to count operator new calls and
+ * bytes, attributed to the pipeline stage running on the calling thread
+ * (the same stages RequestTracer records). Allocations outside any stage,
+ * e.g. IServer::ReceiveMessage() or the application's own code, are counted
+ * as unattributed.
+ *
+ * The counting operator new/delete replacements must be defined in exactly
+ * one translation unit of the test or benchmark executable:
+ *   #define HTTP_ENABLE_ALLOCATION_COUNTING
+ *   #define HTTP_DEFINE_ALLOCATION_HOOKS
+ *   #include "AllocationCounter.h"
+ * Release and firmware builds leave both undefined; every call then compiles
+ * to nothing and the global allocator is untouched.
+ *
+ * Example usage (per-request budget, see LoadHarness::MeasureAllocations and
+ * tests/AllocationBudgetTest.cpp):
+ *   AllocationSnapshot perRequest = harness.MeasureAllocations(0);
+ *   assert(perRequest.Pipeline().allocations <= 12);
+ *   std::cout << perRequest.ToJson() << std::endl;
+ */
+
+struct AllocationCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+/**
+ * Copy of the counters; Since() and PerRequest() turn two snapshots into a budget
+ */
+struct AllocationSnapshot {
+    AllocationCounts stages[TRACE_STAGE_COUNT];
+    AllocationCounts unattributed;
+
+    /**
+     * Allocations made inside pipeline stages
+     */
+    AllocationCounts Pipeline() const {
+        AllocationCounts total;
+        for (const AllocationCounts& stage : stages) {
+            total.allocations += stage.allocations;
+            total.bytes += stage.bytes;
+        }
+        return total;
+    }
+
+    /**
+     * Pipeline stages plus unattributed allocations
+     */
+    AllocationCounts Total() const {
+        AllocationCounts total = Pipeline();
+        total.allocations += unattributed.allocations;
+        total.bytes += unattributed.bytes;
+        return total;
+    }
+
+    AllocationCounts Stage(TraceStage stage) const {
+        return stages[static_cast<Size>(stage)];
+    }
+
+    /**
+     * Counts accumulated after an earlier snapshot
+     */
+    AllocationSnapshot Since(const AllocationSnapshot& earlier) const {
+        AllocationSnapshot delta;
+        for (Size i = 0; i < TRACE_STAGE_COUNT; ++i) {
+            delta.stages[i].allocations = stages[i].allocations - earlier.stages[i].allocations;
+            delta.stages[i].bytes = stages[i].bytes - earlier.stages[i].bytes;
+        }
+        delta.unattributed.allocations = unattributed.allocations - earlier.unattributed.allocations;
+        delta.unattributed.bytes = unattributed.bytes - earlier.unattributed.bytes;
+        return delta;
+    }
+
+    /**
+     * Average per request, rounded up so a budget check never passes on truncation
+     */
+    AllocationSnapshot PerRequest(uint64_t requests) const {
+        AllocationSnapshot average = *this;
+        if (requests <= 1) {
+            return average;
+        }
+        auto divide = [requests](AllocationCounts& counts) {
+            counts.allocations = (counts.allocations + requests - 1) / requests;
+            counts.bytes = (counts.bytes + requests - 1) / requests;
+        };
+        for (AllocationCounts& stage : average.stages) {
+            divide(stage);
+        }
+        divide(average.unattributed);
+        return average;
+    }
+
+    /**
+     * JSON object for reports
+     * e.g. {"dispatch":{"allocations":2,"bytes":96},...,"unattributed":{...}}
+     */
+    StdString ToJson() const {
+        auto counts = [](const AllocationCounts& value) {
+            return "{\"allocations\":" + std::to_string(value.allocations) +
+                   ",\"bytes\":" + std::to_string(value.bytes) + "}";
+        };
+        StdString json = "{";
+        for (Size i = 0; i < TRACE_STAGE_COUNT; ++i) {
+            json += "\"" + StdString(TraceStageName(static_cast<TraceStage>(i))) + "\":" + counts(stages[i]) + ",";
+        }
+        json += "\"unattributed\":" + counts(unattributed) + "}";
+        return json;
+    }
+};
+
+#ifdef HTTP_ENABLE_ALLOCATION_COUNTING
+
+#include <atomic>
+
+class AllocationCounter {
+    // Index TRACE_STAGE_COUNT holds unattributed allocations
+    Private Static constexpr Size unattributedIndex = TRACE_STAGE_COUNT;
+
+    Private struct State {
+        std::atomic<uint64_t> allocations[TRACE_STAGE_COUNT + 1] = {};
+        std::atomic<uint64_t> bytes[TRACE_STAGE_COUNT + 1] = {};
+    };
+
+    // Constant-initialized, so the first operator new call does not allocate
+    Private Static State& GetState() {
+        static State state;
+        return state;
+    }
+
+    Private Static Size& CurrentStageIndex() {
+        static thread_local Size stage = unattributedIndex;
+        return stage;
+    }
+
+    /**
+     * Called by the operator new replacement; must not allocate
+     */
+    Public Static Void RecordAllocation(Size bytes) {
+        State& state = GetState();
+        Size stage = CurrentStageIndex();
+        state.allocations[stage].fetch_add(1, std::memory_order_relaxed);
+        state.bytes[stage].fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * Attribute this thread's allocations to a stage; returns the previous one
+     */
+    Public Static Size EnterStage(TraceStage stage) {
+        Size previous = CurrentStageIndex();
+        CurrentStageIndex() = static_cast<Size>(stage);
+        return previous;
+    }
+
+    Public Static Void RestoreStage(Size previous) {
+        CurrentStageIndex() = previous;
+    }
+
+    Public Static AllocationSnapshot Snapshot() {
+        State& state = GetState();
+        AllocationSnapshot snapshot;
+        for (Size i = 0; i < TRACE_STAGE_COUNT; ++i) {
+            snapshot.stages[i].allocations = state.allocations[i].load(std::memory_order_relaxed);
+            snapshot.stages[i].bytes = state.bytes[i].load(std::memory_order_relaxed);
+        }
+        snapshot.unattributed.allocations = state.allocations[unattributedIndex].load(std::memory_order_relaxed);
+        snapshot.unattributed.bytes = state.bytes[unattributedIndex].load(std::memory_order_relaxed);
+        return snapshot;
+    }
+
+    Public Static Void Reset() {
+        State& state = GetState();
+        for (Size i = 0; i <= TRACE_STAGE_COUNT; ++i) {
+            state.allocations[i].store(0, std::memory_order_relaxed);
+            state.bytes[i].store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * Attributes allocations on this thread to a stage for the duration of a scope
+ * Nested scopes take over and hand back to the enclosing stage on exit.
+ */
+class AllocationStageScope {
+    Private Size previous_;
+
+    Public explicit AllocationStageScope(TraceStage stage)
+        : previous_(AllocationCounter::EnterStage(stage)) {
+    }
+
+    Public ~AllocationStageScope() {
+        AllocationCounter::RestoreStage(previous_);
+    }
+
+    AllocationStageScope(const AllocationStageScope&) = delete;
+    AllocationStageScope& operator=(const AllocationStageScope&) = delete;
+};
+
+#ifdef HTTP_DEFINE_ALLOCATION_HOOKS
+
+#include <cstdlib>
+#include <new>
+
+// Counting replacements for the global allocation functions. The aligned
+// (std::align_val_t) overloads keep the library versions and are not counted;
+// nothing in the request pipeline uses over-aligned types.
+
+void* operator new(std::size_t size) {
+    AllocationCounter::RecordAllocation(size);
+    void* pointer = std::malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    AllocationCounter::RecordAllocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    std::free(pointer);
+}
+
+#endif // HTTP_DEFINE_ALLOCATION_HOOKS
+
+#else
+
+class AllocationCounter {
+    Public Static AllocationSnapshot Snapshot() {
+        return AllocationSnapshot();
+    }
+
+    Public Static Void Reset() {
+    }
+};
+
+class AllocationStageScope {
+    Public explicit AllocationStageScope(TraceStage) {
+    }
+};
+
+#endif // HTTP_ENABLE_ALLOCATION_COUNTING
+
+#endif // ALLOCATION_COUNTER_H
@@ -0,0 +1,90 @@
+#ifndef ALLOWED_METHODS_H
+#define ALLOWED_METHODS_H
+
+#include <StandardDefines.h>
+#include <IHttpRequest.h>
+
+/**
+ * CORS values used for automatic preflight (OPTIONS) responses
+ * Override before including the framework to restrict them.
+ */
+#ifndef HTTP_CORS_ALLOWED_ORIGIN
+#define HTTP_CORS_ALLOWED_ORIGIN "*"
+#endif
+
+#ifndef HTTP_CORS_ALLOWED_HEADERS
+#define HTTP_CORS_ALLOWED_HEADERS "Content-Type, Accept"
+#endif
+
+#ifndef HTTP_CORS_MAX_AGE
+#define HTTP_CORS_MAX_AGE "86400"
+#endif
+
+/**
+ * Bitmask of HTTP methods, one bit per HttpMethod
+ * Stored on every endpoint leaf of the EndpointTrie.
+ */
+typedef UInt HttpMethodMask;
+
+/**
+ * Helper function to get the bit for a single HttpMethod
+ */
+inline HttpMethodMask HttpMethodToMask(HttpMethod method) {
+    switch (method) {
+        case HttpMethod::GET: return 1u << 0;
+        case HttpMethod::HEAD: return 1u << 1;
+        case HttpMethod::POST: return 1u << 2;
+        case HttpMethod::PUT: return 1u << 3;
+        case HttpMethod::PATCH: return 1u << 4;
+        case HttpMethod::DELETE: return 1u << 5;
+        case HttpMethod::OPTIONS: return 1u << 6;
+        case HttpMethod::TRACE: return 1u << 7;
+        case HttpMethod::CONNECT: return 1u << 8;
+    }
+    return 0;
+}
+
+/**
+ * Helper function to check whether a mask contains a method
+ */
+inline Bool IsMethodAllowed(HttpMethodMask mask, HttpMethod method) {
+    return (mask & HttpMethodToMask(method)) != 0;
+}
+
+/**
+ * Helper function to add the methods the dispatcher answers automatically
+ * HEAD is served by the GET handler and OPTIONS from the route table.
+ */
+inline HttpMethodMask WithImplicitMethods(HttpMethodMask mask) {
+    if (IsMethodAllowed(mask, HttpMethod::GET)) {
+        mask |= HttpMethodToMask(HttpMethod::HEAD);
+    }
+    return mask | HttpMethodToMask(HttpMethod::OPTIONS);
+}
+
+/**
+ * Helper function to build an Allow header value from a mask
+ * e.g. "GET, HEAD, POST, OPTIONS"
+ */
+inline StdString AllowHeaderValue(HttpMethodMask mask) {
+    static const HttpMethod kOrder[] = {
+        HttpMethod::GET, HttpMethod::HEAD, HttpMethod::POST, HttpMethod::PUT, HttpMethod::PATCH,
+        HttpMethod::DELETE, HttpMethod::OPTIONS, HttpMethod::TRACE, HttpMethod::CONNECT
+    };
+    static const char* kNames[] = {
+        "GET", "HEAD", "POST", "PUT", "PATCH", "DELETE", "OPTIONS", "TRACE", "CONNECT"
+    };
+
+    StdString value;
+    for (Size i = 0; i < sizeof(kOrder) / sizeof(kOrder[0]); ++i) {
+        if (IsMethodAllowed(mask, kOrder[i])) {
+            if (!value.empty()) {
+                value += ", ";
+            }
+            value += kNames[i];
+        }
+    }
+    return value;
+}
+
+#endif // ALLOWED_METHODS_H
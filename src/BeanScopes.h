@@ -0,0 +1,365 @@
+#ifndef BEAN_SCOPES_H
+#define BEAN_SCOPES_H
+
+#include <StandardDefines.h>
+#include "ObjectPool.h"
+#include "RequestArena.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+/**
+ * Runtime support for the REQUEST and POOLED bean scopes
+ *
+ * The DI preprocessor generates GetInstance() for every component. SINGLETON
+ * and PROTOTYPE need nothing beyond `new`; the two scopes below are backed by
+ * this header, which the preprocessor includes into REQUEST / POOLED beans.
+ *
+ *   @Scope("REQUEST") - one instance per request, constructed in the request's
+ *                       RequestArena and destroyed in bulk when
+ *                       DispatchRequest returns.
+ *   @Scope("POOLED")  - instances drawn from a bounded, thread-safe free list
+ *                       and handed back (not destroyed) when the last
+ *                       reference goes away.
+ */
+
+/**
+ * Maximum number of idle instances each POOLED bean keeps for reuse
+ * Instances released beyond this are destroyed.
+ */
+#ifndef HTTP_BEAN_POOL_CAPACITY
+#define HTTP_BEAN_POOL_CAPACITY 8
+#endif
+
+#if defined(__has_include)
+    #if __has_include(<mutex>)
+        #define HTTP_BEAN_SCOPES_THREADED 1
+    #endif
+#endif
+
+#ifdef HTTP_BEAN_SCOPES_THREADED
+#include <mutex>
+#define HTTP_BEAN_SCOPE_THREAD_LOCAL thread_local
+typedef std::mutex BeanScopeMutex;
+typedef std::lock_guard<std::mutex> BeanScopeLock;
+#else
+// Single-threaded targets: locking is a no-op and there is one current scope
+#define HTTP_BEAN_SCOPE_THREAD_LOCAL
+struct BeanScopeMutex {
+};
+struct BeanScopeLock {
+    explicit BeanScopeLock(BeanScopeMutex&) {
+    }
+};
+#endif
+
+/**
+ * RequestScope - storage for REQUEST beans of the request being dispatched
+ *
+ * HttpRequestDispatcher::DispatchRequest creates one on the stack, over the
+ * request's RequestArena, which makes it the current scope of the calling
+ * thread. Beans are placement-constructed into the arena (heap fallback once it
+ * is full) and are all destroyed, in reverse creation order, when the scope
+ * ends; the arena must outlive the scope.
+ *
+ * Within a scope GetInstance() returns the same instance for the same class.
+ * The returned pointer does not own the bean, so it must not be kept beyond
+ * the request; the DI preprocessor therefore rejects REQUEST beans @Autowired
+ * into SINGLETON or POOLED beans (check_request_scope_injection.py). Outside of
+ * any scope a fresh heap instance is returned, as with PROTOTYPE.
+ */
+class RequestScope {
+    Private struct Bean {
+        const Void* type;
+        Void* instance;
+        Void (*destroy)(Void*);
+        Bool onHeap;
+        Bean* next;
+    };
+
+    Private RequestArena& arena_;
+    Private Bean* beans_;
+    Private RequestScope* previous_;
+
+    Private Static RequestScope*& CurrentSlot() {
+        static HTTP_BEAN_SCOPE_THREAD_LOCAL RequestScope* current = nullptr;
+        return current;
+    }
+
+    template<typename Class>
+    Static const Void* TypeKey() {
+        static const UChar key = 0;
+        return &key;
+    }
+
+    template<typename Class>
+    Static Void Destroy(Void* instance) {
+        static_cast<Class*>(instance)->~Class();
+    }
+
+    Private Static Size AlignUp(Size value) {
+        const Size alignment = alignof(std::max_align_t);
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    /**
+     * Reserve room for a bean record followed by the bean itself
+     */
+    Private Bean* AllocateBean(Size instanceSize, Bool& onHeap) {
+        Size required = AlignUp(sizeof(Bean)) + AlignUp(instanceSize);
+        Void* storage = arena_.Allocate(required, alignof(std::max_align_t));
+        onHeap = storage == nullptr;
+        if (onHeap) {
+            storage = ::operator new(required);
+        }
+        return static_cast<Bean*>(storage);
+    }
+
+    Private Void ReleaseBean(Bean* bean) {
+        if (bean->onHeap) {
+            ::operator delete(bean);
+        }
+    }
+
+    Private Bean* Find(const Void* type) const {
+        for (Bean* bean = beans_; bean != nullptr; bean = bean->next) {
+            if (bean->type == type) {
+                return bean;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Get this scope's instance of Class, constructing it on first use
+     */
+    template<typename Class, typename Interface>
+    std::shared_ptr<Interface> Resolve(Class* (*construct)(Void*)) {
+        static_assert(alignof(Class) <= alignof(std::max_align_t), "Over-aligned beans are not supported by RequestScope");
+
+        Bean* bean = Find(TypeKey<Class>());
+        if (bean == nullptr) {
+            Bool onHeap = false;
+            bean = AllocateBean(sizeof(Class), onHeap);
+            Void* storage = reinterpret_cast<UChar*>(bean) + AlignUp(sizeof(Bean));
+            Class* instance = nullptr;
+            try {
+                instance = construct(storage);
+            } catch (...) {
+                // Arena storage is reclaimed with the arena
+                if (onHeap) {
+                    ::operator delete(bean);
+                }
+                throw;
+            }
+            bean->type = TypeKey<Class>();
+            bean->instance = instance;
+            bean->destroy = &Destroy<Class>;
+            bean->onHeap = onHeap;
+            bean->next = beans_;
+            beans_ = bean;
+        }
+        // Non-owning: the scope destroys the bean, not the shared_ptr
+        return std::shared_ptr<Interface>(std::shared_ptr<Interface>(), static_cast<Class*>(bean->instance));
+    }
+
+public:
+    explicit RequestScope(RequestArena& arena) : arena_(arena), beans_(nullptr), previous_(CurrentSlot()) {
+        CurrentSlot() = this;
+    }
+
+    RequestScope(const RequestScope&) = delete;
+    RequestScope& operator=(const RequestScope&) = delete;
+
+    ~RequestScope() {
+        while (beans_ != nullptr) {
+            Bean* bean = beans_;
+            beans_ = bean->next;
+            bean->destroy(bean->instance);
+            ReleaseBean(bean);
+        }
+        CurrentSlot() = previous_;
+    }
+
+    /**
+     * Get the scope of the request being dispatched on this thread
+     *
+     * @return The current scope, or nullptr outside of DispatchRequest
+     */
+    Static RequestScope* Current() {
+        return CurrentSlot();
+    }
+
+    /**
+     * GetInstance() implementation for @Scope("REQUEST") beans
+     *
+     * @param construct Placement-constructs the bean into the given storage;
+     *                  generated inside the bean so private constructors work
+     */
+    template<typename Class, typename Interface>
+    Static std::shared_ptr<Interface> GetInstance(Class* (*construct)(Void*)) {
+        RequestScope* scope = Current();
+        if (scope == nullptr) {
+            Class* instance = static_cast<Class*>(::operator new(sizeof(Class)));
+            try {
+                construct(instance);
+            } catch (...) {
+                ::operator delete(instance);
+                throw;
+            }
+            return std::shared_ptr<Interface>(instance);
+        }
+        return scope->Resolve<Class, Interface>(construct);
+    }
+};
+
+/**
+ * Detects an optional `Void Reset()` member, called on POOLED beans before
+ * they go back to the pool so per-use state does not leak between users.
+ */
+template<typename T, typename = Void>
+struct has_bean_reset : std::false_type {};
+
+template<typename T>
+struct has_bean_reset<T, std::void_t<decltype(std::declval<T&>().Reset())>> : std::true_type {};
+
+/**
+ * Tag for the lock-guarded block pools used by shared_ptr control blocks of
+ * POOLED beans; keeps them apart from the unsynchronized response pools.
+ */
+struct BeanPoolTag {
+};
+
+inline BeanScopeMutex& BeanPoolAllocatorMutex() {
+    static BeanScopeMutex mutex;
+    return mutex;
+}
+
+/**
+ * BeanPoolAllocator - lock-guarded PoolAllocator for POOLED bean handles
+ */
+template<typename T>
+class BeanPoolAllocator {
+public:
+    typedef T value_type;
+
+    BeanPoolAllocator() noexcept = default;
+
+    template<typename U>
+    BeanPoolAllocator(const BeanPoolAllocator<U>&) noexcept {
+    }
+
+    T* allocate(Size count) {
+        if (count != 1) {
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        BeanScopeLock lock(BeanPoolAllocatorMutex());
+        return static_cast<T*>(FixedBlockPool<sizeof(T), alignof(T), BeanPoolTag>::Instance().Allocate());
+    }
+
+    Void deallocate(T* pointer, Size count) noexcept {
+        if (count != 1) {
+            ::operator delete(pointer);
+            return;
+        }
+        BeanScopeLock lock(BeanPoolAllocatorMutex());
+        FixedBlockPool<sizeof(T), alignof(T), BeanPoolTag>::Instance().Deallocate(pointer);
+    }
+
+    template<typename U>
+    Bool operator==(const BeanPoolAllocator<U>&) const noexcept {
+        return true;
+    }
+
+    template<typename U>
+    Bool operator!=(const BeanPoolAllocator<U>&) const noexcept {
+        return false;
+    }
+};
+
+/**
+ * BeanPool - bounded, thread-safe free list of POOLED bean instances
+ *
+ * Acquire() pops an idle instance (or constructs one when the list is empty)
+ * and wraps it in a shared_ptr whose deleter pushes it back. Instances are
+ * reused as they are; a bean that keeps per-call state should provide a public
+ * `Void Reset()`. At most HTTP_BEAN_POOL_CAPACITY idle instances are kept.
+ */
+template<typename Class, typename Interface>
+class BeanPool {
+    Private BeanScopeMutex mutex_;
+    Private Class* idle_[HTTP_BEAN_POOL_CAPACITY];
+    Private Size idleCount_;
+
+    Private BeanPool() : idle_(), idleCount_(0) {
+    }
+
+    Private struct Releaser {
+        Void operator()(Interface* instance) const {
+            BeanPool::Instance().Release(static_cast<Class*>(instance));
+        }
+    };
+
+    Private Void Release(Class* instance) {
+        if constexpr (has_bean_reset<Class>::value) {
+            instance->Reset();
+        }
+        {
+            BeanScopeLock lock(mutex_);
+            if (idleCount_ < HTTP_BEAN_POOL_CAPACITY) {
+                idle_[idleCount_++] = instance;
+                return;
+            }
+        }
+        delete instance;
+    }
+
+public:
+    BeanPool(const BeanPool&) = delete;
+    BeanPool& operator=(const BeanPool&) = delete;
+
+    ~BeanPool() {
+        while (idleCount_ > 0) {
+            delete idle_[--idleCount_];
+        }
+    }
+
+    /**
+     * Get the pool for this bean class
+     */
+    Static BeanPool& Instance() {
+        static BeanPool pool;
+        return pool;
+    }
+
+    /**
+     * GetInstance() implementation for @Scope("POOLED") beans
+     *
+     * @param construct Creates a new bean when the pool is empty; generated
+     *                  inside the bean so private constructors work
+     */
+    std::shared_ptr<Interface> Acquire(Class* (*construct)()) {
+        Class* instance = nullptr;
+        {
+            BeanScopeLock lock(mutex_);
+            if (idleCount_ > 0) {
+                instance = idle_[--idleCount_];
+            }
+        }
+        if (instance == nullptr) {
+            instance = construct();
+        }
+        return std::shared_ptr<Interface>(static_cast<Interface*>(instance), Releaser(), BeanPoolAllocator<Interface>());
+    }
+
+    /**
+     * Number of idle instances currently cached for reuse
+     */
+    Size GetIdleCount() {
+        BeanScopeLock lock(mutex_);
+        return idleCount_;
+    }
+};
+
+#endif // BEAN_SCOPES_H
@@ -0,0 +1,255 @@
+#ifndef BEAN_STARTUP_H
+#define BEAN_STARTUP_H
+
+#include <StandardDefines.h>
+#include <functional>
+#include <exception>
+
+#ifdef ARDUINO
+    #include <Arduino.h>
+#else
+    #include <chrono>
+    #include <iostream>
+#endif
+
+#ifdef HTTP_BEAN_STARTUP_PARALLEL
+    #include <future>
+#endif
+
+/**
+ * BeanStartup - eager construction of SINGLETON beans before the server starts
+ *
+ * Singletons are otherwise created on their first GetInstance(), so the first
+ * request to each controller pays for opening connections, loading files, etc.
+ * The preprocessor registers every SINGLETON component in
+ * HttpRequestDispatcher::InitializeBeans() together with the interfaces it
+ * autowires, and HttpRequestManager::StartServer() calls Run().
+ *
+ * Run() orders the beans into levels by that dependency graph: a bean is
+ * constructed only after all of its dependencies, one bean at a time.
+ * Beans on a dependency cycle are constructed last, one after the other.
+ *
+ * Define HTTP_BEAN_STARTUP_PARALLEL (host builds with <future>) to construct
+ * the independent beans of a level concurrently with std::async. It is opt-in:
+ * the rest of the library (queues, make_pooled_ptr pools, LoopbackServer) is
+ * unsynchronized, so only enable it when every bean constructor is thread-safe.
+ *
+ * Construction time of every bean is kept in the report (GetReport()), and
+ * printed by Run() when HTTP_BEAN_STARTUP_REPORT is defined.
+ *
+ * Define HTTP_DISABLE_EAGER_BEANS to keep lazy construction.
+ */
+class BeanStartup {
+public:
+    /**
+     * Construction record of one bean
+     */
+    struct BeanTiming {
+        StdString name;
+        UInt level;
+        ULong micros;
+        Bool failed;
+    };
+
+    Private struct BeanRegistration {
+        StdString name;
+        Vector<StdString> dependencies;
+        std::function<Void()> create;
+    };
+
+    Private Vector<BeanRegistration> registrations_;
+    Private Vector<BeanTiming> report_;
+    Private ULong totalMicros_;
+    Private Bool started_;
+
+    Private BeanStartup() : totalMicros_(0), started_(false) {
+    }
+
+    Private Static ULong NowMicros() {
+#ifdef ARDUINO
+        return micros();
+#else
+        return static_cast<ULong>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * Construct one bean and time it
+     * A failing constructor is recorded; the bean is retried lazily on first use.
+     */
+    Private Static BeanTiming Construct(const BeanRegistration& registration, UInt level) {
+        BeanTiming timing{registration.name, level, 0, false};
+        ULong start = NowMicros();
+        try {
+            registration.create();
+        } catch (...) {
+            timing.failed = true;
+        }
+        timing.micros = NowMicros() - start;
+        return timing;
+    }
+
+    /**
+     * Split the registrations into levels of mutually independent beans
+     * Dependencies that are not registered (e.g. PROTOTYPE beans) are ignored.
+     */
+    Private Vector<Vector<Size>> BuildLevels() const {
+        Map<StdString, Size> indexByName;
+        for (Size i = 0; i < registrations_.size(); ++i) {
+            indexByName[registrations_[i].name] = i;
+        }
+
+        Vector<Bool> done(registrations_.size(), false);
+        Vector<Vector<Size>> levels;
+        Size remaining = registrations_.size();
+        while (remaining > 0) {
+            Vector<Size> level;
+            for (Size i = 0; i < registrations_.size(); ++i) {
+                if (done[i]) {
+                    continue;
+                }
+                Bool ready = true;
+                for (const auto& dependency : registrations_[i].dependencies) {
+                    auto it = indexByName.find(dependency);
+                    if (it != indexByName.end() && it->second != i && !done[it->second]) {
+                        ready = false;
+                        break;
+                    }
+                }
+                if (ready) {
+                    level.push_back(i);
+                }
+            }
+
+            if (level.empty()) {
+                // Dependency cycle: leave the rest to sequential construction
+                for (Size i = 0; i < registrations_.size(); ++i) {
+                    if (!done[i]) {
+                        levels.push_back(Vector<Size>{i});
+                        done[i] = true;
+                    }
+                }
+                break;
+            }
+
+            for (Size index : level) {
+                done[index] = true;
+            }
+            remaining -= level.size();
+            levels.push_back(level);
+        }
+        return levels;
+    }
+
+public:
+    BeanStartup(const BeanStartup&) = delete;
+    BeanStartup& operator=(const BeanStartup&) = delete;
+
+    /**
+     * Get the process-wide startup registry
+     */
+    Static BeanStartup& Instance() {
+        static BeanStartup startup;
+        return startup;
+    }
+
+    /**
+     * Register a bean for eager construction
+     *
+     * @param name Bean name (its interface name, as used in dependencies)
+     * @param dependencies Names of the beans it autowires
+     * @param create Resolves the bean, e.g. Implementation<I>::type::GetInstance()
+     */
+    Void Register(CStdString& name, Vector<StdString> dependencies, std::function<Void()> create) {
+        for (const auto& registration : registrations_) {
+            if (registration.name == name) {
+                return;
+            }
+        }
+        registrations_.push_back(BeanRegistration{name, std::move(dependencies), std::move(create)});
+    }
+
+    /**
+     * Construct all registered beans, level by level
+     * Only the first call does anything.
+     */
+    Void Run() {
+#ifndef HTTP_DISABLE_EAGER_BEANS
+        if (started_) {
+            return;
+        }
+        started_ = true;
+
+        ULong start = NowMicros();
+        Vector<Vector<Size>> levels = BuildLevels();
+        for (Size levelIndex = 0; levelIndex < levels.size(); ++levelIndex) {
+            const Vector<Size>& level = levels[levelIndex];
+            UInt levelNumber = static_cast<UInt>(levelIndex);
+#ifdef HTTP_BEAN_STARTUP_PARALLEL
+            if (level.size() > 1) {
+                Vector<std::future<BeanTiming>> pending;
+                pending.reserve(level.size());
+                for (Size index : level) {
+                    const BeanRegistration& registration = registrations_[index];
+                    pending.push_back(std::async(std::launch::async, [&registration, levelNumber]() {
+                        return Construct(registration, levelNumber);
+                    }));
+                }
+                for (auto& future : pending) {
+                    report_.push_back(future.get());
+                }
+                continue;
+            }
+#endif
+            for (Size index : level) {
+                report_.push_back(Construct(registrations_[index], levelNumber));
+            }
+        }
+        totalMicros_ = NowMicros() - start;
+
+#ifdef HTTP_BEAN_STARTUP_REPORT
+        PrintReport();
+#endif
+#endif
+    }
+
+    /**
+     * Per-bean construction times, in construction order
+     */
+    const Vector<BeanTiming>& GetReport() const {
+        return report_;
+    }
+
+    /**
+     * Wall-clock time of the whole eager phase in microseconds
+     */
+    ULong GetTotalMicros() const {
+        return totalMicros_;
+    }
+
+    /**
+     * Print the report, one line per bean
+     * e.g. "[BeanStartup] L1 IUserService 1520us"
+     */
+    Void PrintReport() const {
+        for (const auto& timing : report_) {
+            StdString line = "[BeanStartup] L" + std::to_string(timing.level) + " " + timing.name + " " +
+                             std::to_string(timing.micros) + "us" + (timing.failed ? " FAILED" : "");
+#ifdef ARDUINO
+            Serial.println(line.c_str());
+#else
+            std::cout << line << std::endl;
+#endif
+        }
+        StdString total = "[BeanStartup] " + std::to_string(report_.size()) + " bean(s) in " +
+                          std::to_string(totalMicros_) + "us";
+#ifdef ARDUINO
+        Serial.println(total.c_str());
+#else
+        std::cout << total << std::endl;
+#endif
+    }
+};
+
+#endif // BEAN_STARTUP_H
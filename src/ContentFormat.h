@@ -0,0 +1,17 @@
+#ifndef CONTENT_FORMAT_H
+#define CONTENT_FORMAT_H
+
+#include <StandardDefines.h>
+
+/**
+ * Per-request response options passed from the dispatcher to handlers
+ *
+ * Bodies are always JSON as produced by SerializationUtility.
+ * omitBody is set for HEAD requests answered by a GET handler: the response
+ * carries the Content-Length the body would have, but no body bytes.
+ */
+struct ContentFormat {
+    Bool omitBody = false;
+};
+
+#endif // CONTENT_FORMAT_H
@@ -4,6 +4,9 @@
 #include <StandardDefines.h>
 #include <map>
 #include <vector>
+#include <string_view>
+#include <functional>
+#include "RequestArena.h"
 
 /**
  * Result structure returned when matching an endpoint
@@ -12,10 +15,22 @@ struct EndpointMatchResult {
     StdString pattern;  // The matched endpoint pattern (e.g., "/api/user/{userId}/get")
     Map<StdString, StdString> variables;  // Map of variable names to values (e.g., {"userId": "123"})
     Bool found;  // Whether a match was found
+    UInt allowedMethods;  // Bitmask of HTTP methods registered for the pattern (see AllowedMethods.h)
     
-    EndpointMatchResult() : found(false) {}
-    EndpointMatchResult(const StdString& pat, const Map<StdString, StdString>& vars) 
-        : pattern(pat), variables(vars), found(true) {}
+    EndpointMatchResult() : found(false), allowedMethods(0) {}
+    EndpointMatchResult(const StdString& pat, Map<StdString, StdString> vars, UInt methods = 0) 
+        : pattern(pat), variables(std::move(vars)), found(true), allowedMethods(methods) {}
+};
+
+/**
+ * One pattern registered at a trie leaf
+ * Patterns that differ only in variable names ("/a/{x}" and "/a/{y}") share a leaf,
+ * so each keeps its own variable names and the methods it was registered for.
+ */
+struct EndpointRoute {
+    StdString pattern;
+    Vector<StdString> variableNames;  // In path order
+    UInt methods;
 };
 
 /**
@@ -24,33 +39,32 @@ struct EndpointMatchResult {
 class EndpointTrieNode {
     Private
         // Children for literal path segments (e.g., "user", "api")
-        Map<StdString, EndpointTrieNode*> literalChildren;
+        // Transparent comparator so request segments can be looked up as string_view without copying
+        std::map<StdString, EndpointTrieNode*, std::less<>> literalChildren;
         
         // Child for variable path segments (e.g., "{userId}")
-        // Stores the variable name and the child node
-        Map<StdString, EndpointTrieNode*> variableChildren;  // key: variable name, value: child node
+        // One per node whatever the variable is called; names are kept per route at the leaf
+        EndpointTrieNode* variableChild;
         
-        // Endpoint pattern stored at this node (if this is a leaf)
-        StdString endpointPattern;
-        
-        // Whether this node represents a complete endpoint
-        Bool isEndpoint;
+        // Patterns registered at this node (if this is a leaf)
+        Vector<EndpointRoute> routes;
         
         // Count of literal children (for IsEmpty check)
         Size literalChildrenCount;
+        
+        // Bitmask of HTTP methods registered for the endpoint at this node (all routes)
+        UInt allowedMethods;
 
     Public
-        EndpointTrieNode() : isEndpoint(false), literalChildrenCount(0) {}
+        EndpointTrieNode() : variableChild(nullptr), literalChildrenCount(0), allowedMethods(0) {}
         
         ~EndpointTrieNode() {
             // Clean up literal children
             for (auto& pair : literalChildren) {
                 delete pair.second;
             }
-            // Clean up variable children
-            for (auto& pair : variableChildren) {
-                delete pair.second;
-            }
+            // Clean up the variable child
+            delete variableChild;
         }
         
         // Get or create a literal child node
@@ -62,16 +76,16 @@ class EndpointTrieNode {
             return literalChildren[segment];
         }
         
-        // Get or create a variable child node
-        EndpointTrieNode* GetOrCreateVariableChild(const StdString& variableName) {
-            if (variableChildren.find(variableName) == variableChildren.end()) {
-                variableChildren[variableName] = new EndpointTrieNode();
+        // Get or create the variable child node
+        EndpointTrieNode* GetOrCreateVariableChild() {
+            if (variableChild == nullptr) {
+                variableChild = new EndpointTrieNode();
             }
-            return variableChildren[variableName];
+            return variableChild;
         }
         
         // Get literal child if exists
-        EndpointTrieNode* GetLiteralChild(const StdString& segment) const {
+        EndpointTrieNode* GetLiteralChild(std::string_view segment) const {
             auto it = literalChildren.find(segment);
             if (it != literalChildren.end()) {
                 return it->second;
@@ -79,25 +93,42 @@ class EndpointTrieNode {
             return nullptr;
         }
         
-        // Get all variable children (for matching)
-        const Map<StdString, EndpointTrieNode*>& GetVariableChildren() const {
-            return variableChildren;
+        // Get the variable child (for matching), or nullptr
+        const EndpointTrieNode* GetVariableChild() const {
+            return variableChild;
+        }
+        
+        // Register a pattern at this node, merging its methods into an existing
+        // route with the same pattern
+        Void AddRoute(const StdString& pattern, Vector<StdString> variableNames, UInt methods) {
+            allowedMethods |= methods;
+            for (EndpointRoute& route : routes) {
+                if (route.pattern == pattern) {
+                    route.methods |= methods;
+                    return;
+                }
+            }
+            routes.push_back(EndpointRoute{pattern, std::move(variableNames), methods});
         }
         
-        // Set endpoint pattern at this node
-        Void SetEndpointPattern(const StdString& pattern) {
-            endpointPattern = pattern;
-            isEndpoint = true;
+        // Route registered for a method: the first route serving it, else the first route
+        const EndpointRoute& SelectRoute(UInt method) const {
+            for (const EndpointRoute& route : routes) {
+                if ((route.methods & method) != 0) {
+                    return route;
+                }
+            }
+            return routes.front();
         }
         
-        // Get endpoint pattern
-        StdString GetEndpointPattern() const {
-            return endpointPattern;
+        // Get bitmask of HTTP methods registered for this endpoint
+        UInt GetAllowedMethods() const {
+            return allowedMethods;
         }
         
         // Check if this is an endpoint node
         Bool IsEndpoint() const {
-            return isEndpoint;
+            return !routes.empty();
         }
         
         // Get count of literal children
@@ -107,7 +138,7 @@ class EndpointTrieNode {
         
         // Check if node has any children
         Bool HasChildren() const {
-            return literalChildrenCount > 0 || !variableChildren.empty();
+            return literalChildrenCount > 0 || variableChild != nullptr;
         }
 };
 
@@ -121,27 +152,34 @@ class EndpointTrieNode {
  * 
  * Can match actual paths like:
  * - /api/user/123/get -> matches /api/user/{userId}/get with variables {"userId": "123"}
+ *
+ * Variable segments are matched by position, so "GET /a/{x}" and "POST /a/{y}"
+ * are one route shape: the search reports the methods of both, and the pattern
+ * and variable names of the one registered for the requested method.
  */
 class EndpointTrie {
     Private
         EndpointTrieNode* root;
         
+        // Path-variable values collected while searching (raw segments, in path order)
+        typedef std::string_view VariableBinding;
+        
         /**
-         * Split a path into segments
+         * Split a path into segments (views into the path, nothing is copied)
          * "/api/user/create" -> ["api", "user", "create"]
          * "/api/user/123/" -> ["api", "user", "123", ""] (empty segment for trailing slash)
          * "/api//user" -> ["api", "user"] (empty segments from // are filtered out)
          */
-        Vector<StdString> SplitPath(const StdString& path) const {
-            Vector<StdString> segments;
+        template<typename SegmentVector>
+        Void SplitPath(std::string_view path, SegmentVector& segments) const {
             if (path.empty() || path == "/") {
-                return segments;
+                return;
             }
             
-            StdString current = path;
+            std::string_view current = path;
             // Remove leading slash
             if (current[0] == '/') {
-                current = current.substr(1);
+                current.remove_prefix(1);
             }
             
             // Check if there's a trailing slash (we'll preserve it as an empty segment)
@@ -149,22 +187,22 @@ class EndpointTrie {
             
             // Remove trailing slash temporarily for splitting
             if (hasTrailingSlash) {
-                current = current.substr(0, current.length() - 1);
+                current.remove_suffix(1);
             }
             
             // Split by '/'
             size_t start = 0;
             while (start < current.length()) {
                 size_t pos = current.find('/', start);
-                if (pos == StdString::npos) {
-                    StdString segment = current.substr(start);
+                if (pos == std::string_view::npos) {
+                    std::string_view segment = current.substr(start);
                     // Only add non-empty segments (filters out empty segments from // in middle)
                     if (!segment.empty()) {
                         segments.push_back(segment);
                     }
                     break;
                 } else {
-                    StdString segment = current.substr(start, pos - start);
+                    std::string_view segment = current.substr(start, pos - start);
                     // Only add non-empty segments (handles multiple slashes like "//")
                     if (!segment.empty()) {
                         segments.push_back(segment);
@@ -176,16 +214,14 @@ class EndpointTrie {
             // Add empty segment at the end if there was a trailing slash
             // This distinguishes "/api/user/123" from "/api/user/123/"
             if (hasTrailingSlash) {
-                segments.push_back("");
+                segments.push_back(std::string_view());
             }
-            
-            return segments;
         }
         
         /**
          * Check if a segment is a variable (starts with '{' and ends with '}')
          */
-        Bool IsVariableSegment(const StdString& segment) const {
+        Bool IsVariableSegment(std::string_view segment) const {
             return segment.length() >= 2 && 
                    segment[0] == '{' && 
                    segment[segment.length() - 1] == '}';
@@ -195,31 +231,29 @@ class EndpointTrie {
          * Extract variable name from segment
          * "{userId}" -> "userId"
          */
-        StdString ExtractVariableName(const StdString& segment) const {
+        StdString ExtractVariableName(std::string_view segment) const {
             if (IsVariableSegment(segment)) {
-                return segment.substr(1, segment.length() - 2);
+                return StdString(segment.substr(1, segment.length() - 2));
             }
             return "";
         }
         
         /**
          * Recursive search helper
+         * On success returns the endpoint node and leaves the matching variable bindings in bindings
          */
-        EndpointMatchResult SearchRecursive(
-            EndpointTrieNode* node,
-            const Vector<StdString>& segments,
+        const EndpointTrieNode* SearchRecursive(
+            const EndpointTrieNode* node,
+            const ArenaVector<std::string_view>& segments,
             size_t index,
-            Map<StdString, StdString>& variables
+            ArenaVector<VariableBinding>& bindings
         ) const {
             // If we've processed all segments
             if (index >= segments.size()) {
-                if (node->IsEndpoint()) {
-                    return EndpointMatchResult(node->GetEndpointPattern(), variables);
-                }
-                return EndpointMatchResult();  // No match
+                return node->IsEndpoint() ? node : nullptr;
             }
             
-            StdString currentSegment = segments[index];
+            std::string_view currentSegment = segments[index];
             
             // Special handling for empty segment (trailing slash)
             // If we encounter an empty segment, prefer exact endpoint match over variable match
@@ -231,65 +265,54 @@ class EndpointTrie {
                     // This ensures:
                     // - /xyz/ matches /xyz (exact literal match, no variables consumed)
                     // - /api/user/123/ does NOT match /api/user/{userId} (variable was consumed)
-                    if (node->IsEndpoint() && variables.empty()) {
-                        return EndpointMatchResult(node->GetEndpointPattern(), variables);
+                    if (node->IsEndpoint() && bindings.empty()) {
+                        return node;
                     }
                     // If we consumed variables or node is not an endpoint, no match
                     // This ensures paths with trailing slash don't match patterns without trailing slash
                     // when variables were consumed
-                    return EndpointMatchResult();  // No match - trailing slash doesn't match pattern
+                    return nullptr;  // No match - trailing slash doesn't match pattern
                 }
                 // If there are more segments after the empty one, try variable match
                 // (This handles cases like /api/{var}//something, though uncommon)
-                const Map<StdString, EndpointTrieNode*>& varChildren = node->GetVariableChildren();
-                for (const auto& pair : varChildren) {
-                    StdString varName = pair.first;
-                    EndpointTrieNode* varChild = pair.second;
-                    
-                    // Store the variable value (empty string for trailing slash)
-                    variables[varName] = currentSegment;
-                    
-                    // Continue search with next segment
-                    EndpointMatchResult result = SearchRecursive(varChild, segments, index + 1, variables);
-                    if (result.found) {
-                        return result;
-                    }
-                    
-                    // Backtrack: remove the variable we just tried
-                    variables.erase(varName);
-                }
-                return EndpointMatchResult();  // No match
+                return SearchVariable(node, segments, index, bindings);
             }
             
             // For non-empty segments, try literal match first
-            EndpointTrieNode* literalChild = node->GetLiteralChild(currentSegment);
+            const EndpointTrieNode* literalChild = node->GetLiteralChild(currentSegment);
             if (literalChild != nullptr) {
-                EndpointMatchResult result = SearchRecursive(literalChild, segments, index + 1, variables);
-                if (result.found) {
-                    return result;
+                const EndpointTrieNode* match = SearchRecursive(literalChild, segments, index + 1, bindings);
+                if (match != nullptr) {
+                    return match;
                 }
             }
             
-            // Try variable match (try all variable children)
-            const Map<StdString, EndpointTrieNode*>& varChildren = node->GetVariableChildren();
-            for (const auto& pair : varChildren) {
-                StdString varName = pair.first;
-                EndpointTrieNode* varChild = pair.second;
-                
-                // Store the variable value
-                variables[varName] = currentSegment;
-                
-                // Continue search
-                EndpointMatchResult result = SearchRecursive(varChild, segments, index + 1, variables);
-                if (result.found) {
-                    return result;
-                }
-                
-                // Backtrack: remove the variable we just tried
-                variables.erase(varName);
+            // Try variable match
+            return SearchVariable(node, segments, index, bindings);
+        }
+        
+        /**
+         * Match the segment at index against the node's variable child
+         */
+        const EndpointTrieNode* SearchVariable(
+            const EndpointTrieNode* node,
+            const ArenaVector<std::string_view>& segments,
+            size_t index,
+            ArenaVector<VariableBinding>& bindings
+        ) const {
+            const EndpointTrieNode* variableChild = node->GetVariableChild();
+            if (variableChild == nullptr) {
+                return nullptr;  // No match
             }
             
-            return EndpointMatchResult();  // No match
+            // Store the variable value and continue with the next segment
+            bindings.push_back(segments[index]);
+            const EndpointTrieNode* match = SearchRecursive(variableChild, segments, index + 1, bindings);
+            if (match == nullptr) {
+                // Backtrack: remove the variable we just tried
+                bindings.pop_back();
+            }
+            return match;
         }
 
     Public
@@ -305,36 +328,89 @@ class EndpointTrie {
          * Insert an endpoint pattern into the trie
          * 
          * @param pattern The endpoint pattern (e.g., "/api/user/{userId}/get")
+         * @param methods Bitmask of HTTP methods served by the pattern, merged with earlier inserts
          */
-        Void Insert(const StdString& pattern) {
-            Vector<StdString> segments = SplitPath(pattern);
+        Void Insert(const StdString& pattern, UInt methods = 0) {
+            Vector<std::string_view> segments;
+            SplitPath(pattern, segments);
             EndpointTrieNode* current = root;
+            Vector<StdString> variableNames;
             
-            for (const StdString& segment : segments) {
+            for (std::string_view segment : segments) {
                 if (IsVariableSegment(segment)) {
-                    StdString varName = ExtractVariableName(segment);
-                    current = current->GetOrCreateVariableChild(varName);
+                    variableNames.push_back(ExtractVariableName(segment));
+                    current = current->GetOrCreateVariableChild();
                 } else {
-                    current = current->GetOrCreateLiteralChild(segment);
+                    current = current->GetOrCreateLiteralChild(StdString(segment));
                 }
             }
             
             // Mark as endpoint
-            current->SetEndpointPattern(pattern);
+            current->AddRoute(pattern, std::move(variableNames), methods);
         }
         
         /**
          * Search for a matching endpoint pattern
+         * Segments and variable bindings are allocated from the given arena;
+         * only the returned pattern and variable values are copied out.
          * 
          * @param path The actual path to match (e.g., "/api/user/123/get")
+         * @param arena Per-request arena for temporary allocations
+         * @param method Bitmask of the request method; selects which pattern (and variable
+         *               names) is reported when several share the matched route shape
          * @return EndpointMatchResult containing the matched pattern and variable values
          */
-        EndpointMatchResult Search(const StdString& path) const {
-            Vector<StdString> segments = SplitPath(path);
+        EndpointMatchResult Search(std::string_view path, RequestArena& arena, UInt method = 0) const {
+            ArenaVector<std::string_view> segments = arena.Make<ArenaVector<std::string_view>>();
+            ArenaVector<VariableBinding> bindings = arena.Make<ArenaVector<VariableBinding>>();
+            SplitPath(path, segments);
+            
+            const EndpointTrieNode* match = SearchRecursive(root, segments, 0, bindings);
+            if (match == nullptr) {
+                return EndpointMatchResult();  // No match
+            }
+            
+            const EndpointRoute& route = match->SelectRoute(method);
             Map<StdString, StdString> variables;
-            return SearchRecursive(root, segments, 0, variables);
+            for (Size i = 0; i < bindings.size() && i < route.variableNames.size(); ++i) {
+                variables[route.variableNames[i]] = StdString(bindings[i]);
+            }
+            return EndpointMatchResult(route.pattern, std::move(variables), match->GetAllowedMethods());
         }
         
+        /**
+         * Search for a matching endpoint pattern
+         * 
+         * @param path The actual path to match (e.g., "/api/user/123/get")
+         * @param method Bitmask of the request method (see the arena overload)
+         * @return EndpointMatchResult containing the matched pattern and variable values
+         */
+        EndpointMatchResult Search(std::string_view path, UInt method = 0) const {
+            RequestArena arena;
+            return Search(path, arena, method);
+        }
+
+        /**
+         * Get the methods registered for a pattern's route shape
+         * Includes the methods of every pattern that differs only in variable names.
+         *
+         * @param pattern A registered pattern (e.g., "/api/user/{userId}/get")
+         * @return Bitmask of HTTP methods, 0 if the pattern was never inserted
+         */
+        UInt GetAllowedMethods(std::string_view pattern) const {
+            Vector<std::string_view> segments;
+            SplitPath(pattern, segments);
+            const EndpointTrieNode* current = root;
+
+            for (std::string_view segment : segments) {
+                current = IsVariableSegment(segment) ? current->GetVariableChild() : current->GetLiteralChild(segment);
+                if (current == nullptr) {
+                    return 0;
+                }
+            }
+            return current->GetAllowedMethods();
+        }
+
         /**
          * Check if the trie is empty
          */
@@ -352,4 +428,3 @@ class EndpointTrie {
 };
 
 #endif // ENDPOINT_TRIE_H
-
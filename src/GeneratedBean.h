@@ -0,0 +1,47 @@
+#ifndef GENERATED_BEAN_H
+#define GENERATED_BEAN_H
+
+#include <memory>
+
+/**
+ * Bean binding, specialized for each component by the DI pre-build step
+ * Implementation<Interface>::type is the component class and
+ * Implementation<Interface>::type::GetInstance() returns the bean.
+ */
+template<class T> struct Implementation;
+
+/**
+ * Bean code of a component in a --generated-dir build
+ * The pre-build step writes each component's bean code into its own generated
+ * header, <file name>.beans.h: the Implementation<> specializations and the
+ * class body part this macro expands to (GetInstance() and the @Autowired
+ * injection). The component includes that header after its other includes and
+ * names itself first thing in its class body:
+ *
+ *   #include "IUserService.h"
+ *   #include "UserService.beans.h"
+ *
+ *   class UserService final : public IUserService {
+ *       GeneratedBean(UserService)
+ *       ...
+ *   };
+ *
+ * @Autowired fields are filled right after the constructor returns, so the
+ * constructor cannot use them yet (an @Autowired constructor gets its
+ * arguments before it runs). Builds that rewrite the sources in place comment
+ * both lines out and inject the same code into the class.
+ */
+#define GeneratedBean(ClassName) SPRINGBOOTPLUSPLUS_GENERATED_BEAN_##ClassName
+
+/**
+ * Bean injected into an @Autowired field or constructor argument by generated code
+ * A template, so the bean is looked up where it is instantiated (the end of the
+ * translation unit) rather than in the class body: components whose headers
+ * include each other, e.g. through the dispatcher, need not be complete yet.
+ */
+template<typename Interface>
+std::shared_ptr<Interface> AutowiredBean() {
+    return Implementation<Interface>::type::GetInstance();
+}
+
+#endif // GENERATED_BEAN_H
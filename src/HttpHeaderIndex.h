@@ -0,0 +1,141 @@
+#ifndef HTTP_HEADER_INDEX_H
+#define HTTP_HEADER_INDEX_H
+
+#include <StandardDefines.h>
+#include <string_view>
+
+/**
+ * HttpHeaderIndex - per-request hash index over the request headers
+ *
+ * Built once per request (lazily, on the first header lookup) from the
+ * header map owned by the IHttpRequest. Slots point at the map entries, so
+ * nothing is copied. Lookups hash the name case-insensitively (FNV-1a over
+ * ASCII-lowercased bytes) and probe an open-addressing table.
+ *
+ * The table starts as HTTP_HEADER_INDEX_SLOTS inline slots, enough for 24
+ * headers at 3/4 load (browsers and proxies typically send 10-20). Requests
+ * with more headers grow it to the next power of two on the heap, so every
+ * request gets hashed lookups and only unusual ones allocate.
+ *
+ * Example usage (HttpRequestView::GetHeader):
+ *   index.Build(headers);
+ *   std::string_view deviceId;
+ *   if (index.Find("X-Device-Id", deviceId)) { ... }
+ */
+
+#ifndef HTTP_HEADER_INDEX_SLOTS
+#define HTTP_HEADER_INDEX_SLOTS 32
+#endif
+
+static_assert((HTTP_HEADER_INDEX_SLOTS & (HTTP_HEADER_INDEX_SLOTS - 1)) == 0,
+              "HTTP_HEADER_INDEX_SLOTS must be a power of two");
+
+class HttpHeaderIndex {
+    Private typedef Map<StdString, StdString>::value_type Header;
+
+    Private struct Slot {
+        UInt hash;
+        const Header* header;
+    };
+
+    Private Slot inlineSlots_[HTTP_HEADER_INDEX_SLOTS];
+    Private Vector<Slot> grownSlots_;
+    Private Size mask_ = HTTP_HEADER_INDEX_SLOTS - 1;
+    Private Bool built_ = false;
+
+    Private Static constexpr Char ToLower(Char c) {
+        return (c >= 'A' && c <= 'Z') ? static_cast<Char>(c - 'A' + 'a') : c;
+    }
+
+    Private Static constexpr Bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+        if (a.length() != b.length()) {
+            return false;
+        }
+        for (Size i = 0; i < a.length(); ++i) {
+            if (ToLower(a[i]) != ToLower(b[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Private const Slot* Table() const {
+        return grownSlots_.empty() ? inlineSlots_ : grownSlots_.data();
+    }
+
+public:
+    /**
+     * Case-insensitive FNV-1a hash of a header name (never 0, which marks an empty slot)
+     */
+    Static constexpr UInt Hash(std::string_view name) {
+        UInt hash = 2166136261u;
+        for (Char c : name) {
+            hash ^= static_cast<UChar>(ToLower(c));
+            hash *= 16777619u;
+        }
+        return hash == 0 ? 1u : hash;
+    }
+
+    /**
+     * Index the headers of the current request
+     * The referenced map must outlive the index.
+     */
+    Void Build(const Map<StdString, StdString>& headers) {
+        Size capacity = HTTP_HEADER_INDEX_SLOTS;
+        while (headers.size() > (capacity * 3) / 4) {
+            capacity *= 2;
+        }
+        mask_ = capacity - 1;
+
+        Slot* table = inlineSlots_;
+        if (capacity > HTTP_HEADER_INDEX_SLOTS) {
+            grownSlots_.assign(capacity, Slot{0, nullptr});
+            table = grownSlots_.data();
+        } else {
+            grownSlots_.clear();
+            for (Slot& slot : inlineSlots_) {
+                slot.hash = 0;
+            }
+        }
+
+        for (const Header& header : headers) {
+            UInt hash = Hash(header.first);
+            Size i = hash & mask_;
+            while (table[i].hash != 0) {
+                i = (i + 1) & mask_;
+            }
+            table[i] = Slot{hash, &header};
+        }
+        built_ = true;
+    }
+
+    /**
+     * Whether Build() has been called
+     */
+    Bool IsBuilt() const {
+        return built_;
+    }
+
+    /**
+     * Find a header value by name (case-insensitive)
+     *
+     * @param name Header name
+     * @param value Set to a view of the header value if found
+     * @return true if the header is present
+     */
+    Bool Find(std::string_view name, std::string_view& value) const {
+        const Slot* table = Table();
+        UInt hash = Hash(name);
+        Size i = hash & mask_;
+        while (table[i].hash != 0) {
+            if (table[i].hash == hash && EqualsIgnoreCase(table[i].header->first, name)) {
+                value = table[i].header->second;
+                return true;
+            }
+            i = (i + 1) & mask_;
+        }
+        return false;
+    }
+};
+
+#endif // HTTP_HEADER_INDEX_H
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cctype>
 #include <iomanip>
+#include <charconv>
 
 #ifdef ARDUINO
     #include <Arduino.h>
@@ -25,110 +26,315 @@
 #include "IHttpRequestDispatcher.h"
 #include <IHttpResponse.h>
 #include "ResponseEntityToHttpResponse.h"
+#include "ContentFormat.h"
+#include "AllowedMethods.h"
+#include "HttpRequestView.h"
+#include "BeanScopes.h"
+#include "BeanStartup.h"
+#include "RequestTracer.h"
+#include "GeneratedBean.h"
+
+/**
+ * Generated code (written by the pre-build script into the build directory)
+ * When the generated directory is on the include path, mappings, bean startup and
+ * their includes come from there and this header is never rewritten. The bean code
+ * of each component is in the same directory, in the <component>.beans.h header the
+ * component includes itself (see GeneratedBean.h).
+ */
+#if defined(__has_include)
+    #if __has_include(<HttpRequestDispatcherGenerated.h>)
+        #define HTTP_REQUEST_DISPATCHER_GENERATED 1
+    #endif
+#endif
+
+#ifdef HTTP_REQUEST_DISPATCHER_GENERATED
+#include <HttpRequestDispatcherGenerated.h>
+#endif
+#include "HttpRequestDispatcher.beans.h"
+
+/**
+ * Global maximum request body size in bytes (0 disables the limit)
+ * Disabled by default, as before limits existed; projects opt in with a build flag
+ * (e.g. -DHTTP_MAX_REQUEST_BODY_SIZE=65536). Individual routes can set or override
+ * it with the MaxBodySize annotation.
+ */
+#ifndef HTTP_MAX_REQUEST_BODY_SIZE
+#define HTTP_MAX_REQUEST_BODY_SIZE 0
+#endif
+
+/**
+ * Route handler
+ * A plain function pointer: generated handlers are captureless lambdas, so a call
+ * is one indirect jump with no type erasure or heap-allocated state.
+ */
+typedef IHttpResponsePtr (*HttpRequestHandler)(const HttpRequestView&, const ContentFormat&);
+
+/**
+ * Static type generated handlers call a bean through
+ * A final implementation cannot be wrapped by a validator (validators derive from it),
+ * so the bean is exactly Implementation<Interface>::type and calls on it bind directly,
+ * where the compiler can inline them. Non-final implementations stay on the interface.
+ */
+template<typename Interface>
+using DevirtualizedBean = std::conditional_t<std::is_final_v<typename Implementation<Interface>::type>,
+                                             typename Implementation<Interface>::type, Interface>;
+
+/**
+ * SINGLETON bean slot for generated handlers
+ * Resolve() is the bean's BeanStartup entry, so the slot is filled while the bean is
+ * constructed in its place in the startup order (HttpRequestManager::StartServer()).
+ * A handler then reads the bean with Get(): a plain load and a null check instead of a
+ * function-local static's initialization guard and a shared_ptr copy per request.
+ * Get() resolves the slot itself if startup did not run (HTTP_DISABLE_EAGER_BEANS,
+ * or a dispatcher used without HttpRequestManager).
+ * The bean itself stays owned by its GetInstance().
+ */
+template<typename Interface>
+struct SingletonBeanSlot {
+    Static inline DevirtualizedBean<Interface>* instance = nullptr;
+
+    Static Void Resolve() {
+        if (instance == nullptr) {
+            instance = &static_cast<DevirtualizedBean<Interface>&>(*Implementation<Interface>::type::GetInstance());
+        }
+    }
+
+    Static DevirtualizedBean<Interface>& Get() {
+        if (instance == nullptr) {
+            Resolve();
+        }
+        return *instance;
+    }
+};
+
+/**
+ * BeanStartup entry of a SINGLETON bean (generated into InitializeBeans())
+ * A function template, so the slot is only instantiated at the end of the translation
+ * unit: a bean that autowires the dispatcher includes it before its own class, and is
+ * still incomplete where the dispatcher is compiled.
+ */
+template<typename Interface>
+Void ResolveSingletonBean() {
+    SingletonBeanSlot<Interface>::Resolve();
+}
+
+/**
+ * Whether Implementation<Interface>::type::GetInstance() returns one shared instance
+ * Read from Implementation<Interface>::singleton, which the DI step generates from
+ * the bean's scope; specializations without it are treated as not singleton.
+ */
+template<typename Interface, typename = void>
+struct is_singleton_bean : std::false_type {};
+
+template<typename Interface>
+struct is_singleton_bean<Interface, std::void_t<decltype(Implementation<Interface>::singleton)>>
+    : std::bool_constant<Implementation<Interface>::singleton> {};
+
+template<typename Interface>
+inline constexpr Bool is_singleton_bean_v = is_singleton_bean<Interface>::value;
 
 /* @Component */
 class HttpRequestDispatcher : public IHttpRequestDispatcher {
+    GeneratedBean(HttpRequestDispatcher)
 
-    Private UnorderedMap<StdString, std::function<IHttpResponsePtr(CStdString, Map<StdString, StdString>)>> getMappings;
-    Private UnorderedMap<StdString, std::function<IHttpResponsePtr(CStdString, Map<StdString, StdString>)>> postMappings;
-    Private UnorderedMap<StdString, std::function<IHttpResponsePtr(CStdString, Map<StdString, StdString>)>> putMappings;
-    Private UnorderedMap<StdString, std::function<IHttpResponsePtr(CStdString, Map<StdString, StdString>)>> patchMappings;
-    Private UnorderedMap<StdString, std::function<IHttpResponsePtr(CStdString, Map<StdString, StdString>)>> deleteMappings;
-    Private UnorderedMap<StdString, std::function<IHttpResponsePtr(CStdString, Map<StdString, StdString>)>> optionsMappings;
-    Private UnorderedMap<StdString, std::function<IHttpResponsePtr(CStdString, Map<StdString, StdString>)>> headMappings;
-    Private UnorderedMap<StdString, std::function<IHttpResponsePtr(CStdString, Map<StdString, StdString>)>> traceMappings;
-    Private UnorderedMap<StdString, std::function<IHttpResponsePtr(CStdString, Map<StdString, StdString>)>> connectMappings;
+    Private UnorderedMap<StdString, HttpRequestHandler> getMappings;
+    Private UnorderedMap<StdString, HttpRequestHandler> postMappings;
+    Private UnorderedMap<StdString, HttpRequestHandler> putMappings;
+    Private UnorderedMap<StdString, HttpRequestHandler> patchMappings;
+    Private UnorderedMap<StdString, HttpRequestHandler> deleteMappings;
+    Private UnorderedMap<StdString, HttpRequestHandler> optionsMappings;
+    Private UnorderedMap<StdString, HttpRequestHandler> headMappings;
+    Private UnorderedMap<StdString, HttpRequestHandler> traceMappings;
+    Private UnorderedMap<StdString, HttpRequestHandler> connectMappings;
 
     Private EndpointTrie endpointTrie;
 
+    /**
+     * Headers and bodies of the 405 Method Not Allowed and automatic OPTIONS / CORS
+     * preflight replies, computed once per allowed-methods bitmask
+     * Each reply is still a new SimpleHttpResponse holding a copy of them, since a
+     * response carries its own request ID.
+     */
+    Private struct RouteResponseParts {
+        Map<StdString, StdString> methodNotAllowedHeaders;
+        StdString methodNotAllowedBody;
+        Map<StdString, StdString> optionsHeaders;
+        Map<StdString, StdString> preflightHeaders;
+    };
+
+    Private UnorderedMap<HttpMethodMask, RouteResponseParts> routeResponseParts;
+
+    // Per-route body size limits from MaxBodySize annotations: pattern -> method bit -> bytes
+    Private UnorderedMap<StdString, Map<HttpMethodMask, Size>> routeMaxBodySizes;
+
+    /**
+     * Route registered from C++ (Router.h) rather than by the code generator
+     */
+    Private struct RegisteredRoute {
+        HttpMethod method;
+        StdString pattern;
+        HttpRequestHandler handler;
+    };
+
+    Private Static Vector<RegisteredRoute>& RegisteredRoutes() {
+        static Vector<RegisteredRoute> routes;
+        return routes;
+    }
+
     Public HttpRequestDispatcher() {
         InitializeMappings();
+        InitializeGeneratedMappings();
+        InitializeRegisteredMappings();
         InsertMappingsToTrie();
+        InitializeBeans();
+        InitializeGeneratedBeans();
     }
 
     Public ~HttpRequestDispatcher() = default;
 
     Public IHttpResponsePtr DispatchRequest(IHttpRequestPtr request) override {
-        CStdString url = request->GetPath();
-        CStdString payload = request->GetBody();
+        // Bind the request accessors by reference so nothing is copied when the
+        // server exposes its buffers; handlers only ever see views into them
+        const auto& requestId = request->GetRequestId();
+        const auto& target = request->GetPath();
+        const auto& body = request->GetBody();
+        const auto& headers = request->GetHeaders();
+        HttpRequestView view(requestId, target, body, headers);
+
+        // Sampled requests record their dispatch stages (see RequestTracer.h)
+        RequestTraceScope traceScope(requestId);
+        RequestTraceSpan dispatchSpan(TraceStage::DISPATCH);
         
-        EndpointMatchResult result = endpointTrie.Search(url);
+        // Scratch allocations for route matching and REQUEST beans live in a
+        // per-request arena, released in bulk when this function returns
+        // The method picks the pattern (and variable names) when several patterns
+        // share the matched route shape, e.g. GET /a/{x} and POST /a/{y}
+        RequestArena arena;
+        HttpMethod method = request->GetMethod();
+        EndpointMatchResult result = [&] {
+            RequestTraceSpan routingSpan(TraceStage::ROUTING);
+            return endpointTrie.Search(view.GetPath(), arena, HttpMethodToMask(method));
+        }();
         if(result.found == false) {
             // Return 404 Not Found
-            StdString errorJson = "{\"error\":\"Not Found\",\"message\":\"No pattern matched for URL: " + url + "\"}";
+            StdString errorJson = "{\"error\":\"Not Found\",\"message\":\"No pattern matched for URL: " + StdString(view.GetPath()) + "\"}";
             ResponseEntity<StdString> errorResponse = ResponseEntity<StdString>::NotFound(errorJson);
             IHttpResponsePtr response = ResponseEntityConverter::ToHttpResponse<StdString>(errorResponse);
-            StdString requestId = StdString(request->GetRequestId());
             if (!requestId.empty()) {
                 response->SetRequestId(requestId);
             }
             return response;
         }
         
-        Val variables = result.variables;
-        Val patternUrl = result.pattern;
-        
-        // Get request ID from the request
-        StdString requestId = StdString(request->GetRequestId());
+        CStdString& patternUrl = result.pattern;
+        view.SetPattern(patternUrl);
+        view.SetPathVariables(result.variables);
+
+        // @Scope("REQUEST") beans resolved while handling this request live in
+        // the same arena and are destroyed in bulk when this function returns
+        RequestScope requestScope(arena);
+
+        // Path matched but method is not served by it - 405 with Allow header
+        if (!IsMethodAllowed(result.allowedMethods, method)) {
+            return CreateMethodNotAllowedResponse(result.allowedMethods, requestId);
+        }
+
+        // OPTIONS without an explicit mapping is answered from the route table
+        if (method == HttpMethod::OPTIONS && optionsMappings.find(patternUrl) == optionsMappings.end()) {
+            return CreateOptionsResponse(result.allowedMethods, requestId, view);
+        }
+
+        // Reject oversized bodies before deserialization
+        Size maxBodySize = GetMaxBodySize(method, patternUrl);
+        if (maxBodySize > 0 && GetDeclaredBodySize(view) > maxBodySize) {
+            return CreatePayloadTooLargeResponse(requestId);
+        }
+
+        // Response options; HEAD served by a GET handler sets omitBody below
+        ContentFormat format;
 
         try {
+            RequestTraceSpan handlerSpan(TraceStage::HANDLER);
             IHttpResponsePtr response = nullptr;
             
-            switch (request->GetMethod()) {
-                case HttpMethod::GET:
-                    if (getMappings.find(patternUrl) == getMappings.end()) {
-                        return nullptr;
+            switch (method) {
+                case HttpMethod::GET: {
+                    auto handler = getMappings.find(patternUrl);
+                    if (handler == getMappings.end()) {
+                        return CreateMethodNotAllowedResponse(result.allowedMethods, requestId);
                     }
-                    response = getMappings[patternUrl](payload, variables);
+                    response = handler->second(view, format);
                     break;
-                case HttpMethod::POST:
-                    if (postMappings.find(patternUrl) == postMappings.end()) {
-                        return nullptr;
+                }
+                case HttpMethod::POST: {
+                    auto handler = postMappings.find(patternUrl);
+                    if (handler == postMappings.end()) {
+                        return CreateMethodNotAllowedResponse(result.allowedMethods, requestId);
                     }
-                    response = postMappings[patternUrl](payload, variables);
+                    response = handler->second(view, format);
                     break;
-                case HttpMethod::PUT:
-                    if (putMappings.find(patternUrl) == putMappings.end()) {
-                        return nullptr;
+                }
+                case HttpMethod::PUT: {
+                    auto handler = putMappings.find(patternUrl);
+                    if (handler == putMappings.end()) {
+                        return CreateMethodNotAllowedResponse(result.allowedMethods, requestId);
                     }
-                    response = putMappings[patternUrl](payload, variables);
+                    response = handler->second(view, format);
                     break;
-                case HttpMethod::PATCH:
-                    if (patchMappings.find(patternUrl) == patchMappings.end()) {
-                        return nullptr;
+                }
+                case HttpMethod::PATCH: {
+                    auto handler = patchMappings.find(patternUrl);
+                    if (handler == patchMappings.end()) {
+                        return CreateMethodNotAllowedResponse(result.allowedMethods, requestId);
                     }
-                    response = patchMappings[patternUrl](payload, variables);
+                    response = handler->second(view, format);
                     break;
-                case HttpMethod::DELETE:
-                    if (deleteMappings.find(patternUrl) == deleteMappings.end()) {
-                        return nullptr;
+                }
+                case HttpMethod::DELETE: {
+                    auto handler = deleteMappings.find(patternUrl);
+                    if (handler == deleteMappings.end()) {
+                        return CreateMethodNotAllowedResponse(result.allowedMethods, requestId);
                     }
-                    response = deleteMappings[patternUrl](payload, variables);
+                    response = handler->second(view, format);
                     break;
-                case HttpMethod::OPTIONS:
-                    if (optionsMappings.find(patternUrl) == optionsMappings.end()) {
-                        return nullptr;
+                }
+                case HttpMethod::OPTIONS: {
+                    auto handler = optionsMappings.find(patternUrl);
+                    if (handler == optionsMappings.end()) {
+                        return CreateMethodNotAllowedResponse(result.allowedMethods, requestId);
                     }
-                    response = optionsMappings[patternUrl](payload, variables);
+                    response = handler->second(view, format);
                     break;
-                case HttpMethod::HEAD:
-                    if (headMappings.find(patternUrl) == headMappings.end()) {
-                        return nullptr;
+                }
+                case HttpMethod::HEAD: {
+                    auto handler = headMappings.find(patternUrl);
+                    if (handler == headMappings.end()) {
+                        // Automatic HEAD - run the GET handler, report Content-Length, send no body
+                        handler = getMappings.find(patternUrl);
+                        if (handler == getMappings.end()) {
+                            return CreateMethodNotAllowedResponse(result.allowedMethods, requestId);
+                        }
+                        format.omitBody = true;
                     }
-                    response = headMappings[patternUrl](payload, variables);
+                    response = handler->second(view, format);
                     break;
-                case HttpMethod::TRACE:
-                    if (traceMappings.find(patternUrl) == traceMappings.end()) {
-                        return nullptr;
+                }
+                case HttpMethod::TRACE: {
+                    auto handler = traceMappings.find(patternUrl);
+                    if (handler == traceMappings.end()) {
+                        return CreateMethodNotAllowedResponse(result.allowedMethods, requestId);
                     }
-                    response = traceMappings[patternUrl](payload, variables);
+                    response = handler->second(view, format);
                     break;
-                case HttpMethod::CONNECT:
-                    if (connectMappings.find(patternUrl) == connectMappings.end()) {
-                        return nullptr;
+                }
+                case HttpMethod::CONNECT: {
+                    auto handler = connectMappings.find(patternUrl);
+                    if (handler == connectMappings.end()) {
+                        return CreateMethodNotAllowedResponse(result.allowedMethods, requestId);
                     }
-                    response = connectMappings[patternUrl](payload, variables);
+                    response = handler->second(view, format);
                     break;
+                }
             }
             
             // If response was created without request ID, set it now
@@ -165,34 +371,211 @@ class HttpRequestDispatcher : public IHttpRequestDispatcher {
 
     }
 
+    /**
+     * Register SINGLETON beans for eager construction (generated)
+     * Run by HttpRequestManager::StartServer() through BeanStartup.
+     */
+    Private Void InitializeBeans() {
+
+    }
+
+    /**
+     * Mappings and bean registrations generated into the build directory
+     * Empty when the sources were rewritten in place instead.
+     */
+    Private Void InitializeGeneratedMappings() {
+#ifdef HTTP_REQUEST_DISPATCHER_GENERATED
+        #include <HttpRequestDispatcherMappings.inc>
+#endif
+    }
+
+    Private Void InitializeGeneratedBeans() {
+#ifdef HTTP_REQUEST_DISPATCHER_GENERATED
+        #include <HttpRequestDispatcherBeans.inc>
+#endif
+    }
+
+    /**
+     * Add the routes registered through RegisterRoute() (a route registered for the
+     * same method and pattern as a generated mapping replaces it)
+     */
+    Private Void InitializeRegisteredMappings() {
+        for (const RegisteredRoute& route : RegisteredRoutes()) {
+            MappingsFor(route.method)[route.pattern] = route.handler;
+        }
+    }
+
+    Private UnorderedMap<StdString, HttpRequestHandler>& MappingsFor(HttpMethod method) {
+        switch (method) {
+            case HttpMethod::POST: return postMappings;
+            case HttpMethod::PUT: return putMappings;
+            case HttpMethod::PATCH: return patchMappings;
+            case HttpMethod::DELETE: return deleteMappings;
+            case HttpMethod::OPTIONS: return optionsMappings;
+            case HttpMethod::HEAD: return headMappings;
+            case HttpMethod::TRACE: return traceMappings;
+            case HttpMethod::CONNECT: return connectMappings;
+            default: return getMappings;
+        }
+    }
+
     Private Void InsertMappingsToTrie() {
+        // Collect the methods served by each pattern
+        Map<StdString, HttpMethodMask> routeMethods;
         for (const auto& pair : getMappings) {
-            endpointTrie.Insert(pair.first);
+            routeMethods[pair.first] |= HttpMethodToMask(HttpMethod::GET);
         }
         for (const auto& pair : postMappings) {
-            endpointTrie.Insert(pair.first);
+            routeMethods[pair.first] |= HttpMethodToMask(HttpMethod::POST);
         }
         for (const auto& pair : putMappings) {
-            endpointTrie.Insert(pair.first);
+            routeMethods[pair.first] |= HttpMethodToMask(HttpMethod::PUT);
         }
         for (const auto& pair : patchMappings) {
-            endpointTrie.Insert(pair.first);
+            routeMethods[pair.first] |= HttpMethodToMask(HttpMethod::PATCH);
         }
         for (const auto& pair : deleteMappings) {
-            endpointTrie.Insert(pair.first);
+            routeMethods[pair.first] |= HttpMethodToMask(HttpMethod::DELETE);
         }
         for (const auto& pair : optionsMappings) {
-            endpointTrie.Insert(pair.first);
+            routeMethods[pair.first] |= HttpMethodToMask(HttpMethod::OPTIONS);
         }
         for (const auto& pair : headMappings) {
-            endpointTrie.Insert(pair.first);
+            routeMethods[pair.first] |= HttpMethodToMask(HttpMethod::HEAD);
         }
         for (const auto& pair : traceMappings) {
-            endpointTrie.Insert(pair.first);
+            routeMethods[pair.first] |= HttpMethodToMask(HttpMethod::TRACE);
         }
         for (const auto& pair : connectMappings) {
-            endpointTrie.Insert(pair.first);
+            routeMethods[pair.first] |= HttpMethodToMask(HttpMethod::CONNECT);
+        }
+
+        // Patterns differing only in variable names share a trie leaf, which
+        // keeps each pattern's own methods for handler lookup
+        for (const auto& route : routeMethods) {
+            endpointTrie.Insert(route.first, WithImplicitMethods(route.second));
+        }
+
+        // 405 / OPTIONS replies advertise every method of the route shape
+        for (const auto& route : routeMethods) {
+            HttpMethodMask methods = endpointTrie.GetAllowedMethods(route.first);
+            if (routeResponseParts.find(methods) == routeResponseParts.end()) {
+                routeResponseParts[methods] = BuildRouteResponseParts(methods);
+            }
+        }
+    }
+
+    /**
+     * Set the maximum request body size for one route (emitted by the code generator)
+     *
+     * @param method The HTTP method of the route
+     * @param pattern The endpoint pattern
+     * @param maxBodySize Limit in bytes (0 disables the limit for this route)
+     */
+    Private Void SetMaxBodySize(HttpMethod method, CStdString& pattern, Size maxBodySize) {
+        routeMaxBodySizes[pattern][HttpMethodToMask(method)] = maxBodySize;
+    }
+
+    /**
+     * Get the body size limit that applies to a route
+     * HEAD requests served by a GET handler use the GET limit.
+     */
+    Private Size GetMaxBodySize(HttpMethod method, CStdString& patternUrl) const {
+        auto route = routeMaxBodySizes.find(patternUrl);
+        if (route != routeMaxBodySizes.end()) {
+            auto limit = route->second.find(HttpMethodToMask(method));
+            if (limit == route->second.end() && method == HttpMethod::HEAD) {
+                limit = route->second.find(HttpMethodToMask(HttpMethod::GET));
+            }
+            if (limit != route->second.end()) {
+                return limit->second;
+            }
+        }
+        return HTTP_MAX_REQUEST_BODY_SIZE;
+    }
+
+    /**
+     * Get the request body size, preferring the declared Content-Length
+     */
+    Private Static Size GetDeclaredBodySize(const HttpRequestView& view) {
+        std::string_view contentLength = view.GetHeader("Content-Length");
+        if (!contentLength.empty()) {
+            Size declared = 0;
+            Bool valid = true;
+            for (Char c : contentLength) {
+                if (c < '0' || c > '9') {
+                    valid = false;
+                    break;
+                }
+                declared = declared * 10 + static_cast<Size>(c - '0');
+            }
+            if (valid) {
+                return std::max(declared, view.GetBody().size());
+            }
         }
+        return view.GetBody().size();
+    }
+
+    /**
+     * Create the canned 413 Payload Too Large response
+     */
+    Private Static IHttpResponsePtr CreatePayloadTooLargeResponse(CStdString& requestId) {
+        static const Map<StdString, StdString> headers = {
+            {"Content-Type", "application/json"},
+            {"Connection", "close"}
+        };
+        static CStdString body = "{\"error\":\"Payload Too Large\",\"message\":\"Request body exceeds the maximum allowed size\"}";
+        HttpStatus status = HttpStatus::PAYLOAD_TOO_LARGE;
+        return make_pooled_ptr<SimpleHttpResponse>(requestId, StatusToInt(status), GetStatusMessage(status), headers, body);
+    }
+
+    /**
+     * Compute the 405 and OPTIONS headers and bodies for an allowed-methods bitmask
+     *
+     * @param methods Bitmask of methods the route answers (including implicit HEAD / OPTIONS)
+     * @return Headers and bodies copied into every such reply
+     */
+    Private Static RouteResponseParts BuildRouteResponseParts(HttpMethodMask methods) {
+        StdString allow = AllowHeaderValue(methods);
+        RouteResponseParts responses;
+
+        responses.methodNotAllowedHeaders["Allow"] = allow;
+        responses.methodNotAllowedHeaders["Content-Type"] = "application/json";
+        responses.methodNotAllowedBody = "{\"error\":\"Method Not Allowed\",\"message\":\"Allowed methods: " + allow + "\"}";
+
+        responses.optionsHeaders["Allow"] = allow;
+
+        responses.preflightHeaders["Allow"] = allow;
+        responses.preflightHeaders["Access-Control-Allow-Origin"] = HTTP_CORS_ALLOWED_ORIGIN;
+        responses.preflightHeaders["Access-Control-Allow-Methods"] = allow;
+        responses.preflightHeaders["Access-Control-Allow-Headers"] = HTTP_CORS_ALLOWED_HEADERS;
+        responses.preflightHeaders["Access-Control-Max-Age"] = HTTP_CORS_MAX_AGE;
+        return responses;
+    }
+
+    /**
+     * Create a 405 Method Not Allowed response from the route's precomputed headers and body
+     */
+    Private IHttpResponsePtr CreateMethodNotAllowedResponse(HttpMethodMask allowedMethods, CStdString& requestId) const {
+        const RouteResponseParts& parts = routeResponseParts.at(allowedMethods);
+        HttpStatus status = HttpStatus::METHOD_NOT_ALLOWED;
+        return make_pooled_ptr<SimpleHttpResponse>(requestId, StatusToInt(status), GetStatusMessage(status),
+                                            parts.methodNotAllowedHeaders, parts.methodNotAllowedBody);
+    }
+
+    /**
+     * Create a 204 response to OPTIONS from the route's precomputed headers
+     * CORS preflight requests (Origin + Access-Control-Request-Method) also get the CORS headers
+     */
+    Private IHttpResponsePtr CreateOptionsResponse(HttpMethodMask allowedMethods, CStdString& requestId,
+                                                   const HttpRequestView& request) const {
+        const RouteResponseParts& parts = routeResponseParts.at(allowedMethods);
+        Bool isPreflight = !request.GetHeader("Origin").empty() &&
+                           !request.GetHeader("Access-Control-Request-Method").empty();
+        HttpStatus status = HttpStatus::NO_CONTENT;
+        StdString emptyBody = "";
+        return make_pooled_ptr<SimpleHttpResponse>(requestId, StatusToInt(status), GetStatusMessage(status),
+                                            isPreflight ? parts.preflightHeaders : parts.optionsHeaders, emptyBody);
     }
 
     /**
@@ -202,7 +585,7 @@ class HttpRequestDispatcher : public IHttpRequestDispatcher {
      * @param str The URL-encoded string to decode
      * @return The decoded string
      */
-    Private Static StdString UrlDecode(CStdString str) {
+    Private Static StdString UrlDecode(CStdString& str) {
         StdString result;
         result.reserve(str.length()); // Reserve space for efficiency
         
@@ -237,6 +620,48 @@ class HttpRequestDispatcher : public IHttpRequestDispatcher {
         
         return result;
     }   
+
+    /**
+     * Register a route handler without the code generator (see Router.h)
+     * Routes must be registered before the dispatcher is constructed, i.e. before
+     * the server starts; they are added next to the generated mappings.
+     * 
+     * @param method HTTP method of the route
+     * @param pattern Route pattern, e.g. "/api/user/{id}"
+     * @param handler Handler called with the request view and response format
+     */
+    Public Static Void RegisterRoute(HttpMethod method, CStdString& pattern, HttpRequestHandler handler) {
+        RegisteredRoutes().push_back(RegisteredRoute{method, pattern, handler});
+    }
+
+    /**
+     * Template function to deserialize a request body (RequestBody parameters).
+     *
+     * SerializationUtility::Deserialize only takes a StdString, so the body is
+     * copied once out of the view; the view itself avoids the earlier copies
+     * of the request.
+     * 
+     * @tparam Type The target type to deserialize to
+     * @param body View of the request body
+     * @return The deserialized value of type Type
+     */
+    Public template<typename Type>
+    Static Type DeserializeBody(std::string_view body) {
+        return nayan::serializer::SerializationUtility::Deserialize<Type>(StdString(body));
+    }
+
+    /**
+     * Bean reference for generated handlers, typed as precisely as is safe.
+     * 
+     * @tparam Interface The bean interface
+     * @param instance The bean returned by GetInstance()
+     * @return The bean as DevirtualizedBean<Interface>
+     */
+    Public template<typename Interface>
+    Static DevirtualizedBean<Interface>& Devirtualize(Interface& instance) {
+        return static_cast<DevirtualizedBean<Interface>&>(instance);
+    }
+
     /**
      * Template function to convert a string to a given type.
      * 
@@ -249,7 +674,7 @@ class HttpRequestDispatcher : public IHttpRequestDispatcher {
      * @return The converted value of type Type
      */
     Public template<typename Type>
-    Static Type ConvertToType(CStdString str) {
+    Static Type ConvertToType(CStdString& str) {
         // Handle string types - URL decode first, then return
         if constexpr (std::is_same_v<Type, StdString> || 
                       std::is_same_v<Type, CStdString> ||
@@ -341,6 +766,43 @@ class HttpRequestDispatcher : public IHttpRequestDispatcher {
         }
     }
 
+    /**
+     * Template function to read a request header as a given type (RequestHeader parameters).
+     * 
+     * - std::string_view is returned as a view into the request's header map (no copy)
+     * - String types are copied as-is (headers are not URL-encoded)
+     * - Integer types are parsed in place from the header view
+     * - Anything else goes through ConvertToType
+     * 
+     * @tparam Type The target type to convert to
+     * @param request The request being dispatched
+     * @param name The header name (case-insensitive)
+     * @return The header value converted to Type
+     * @throws std::invalid_argument if the header is missing or cannot be converted
+     */
+    Public template<typename Type>
+    Static Type ConvertHeader(const HttpRequestView& request, std::string_view name) {
+        std::string_view value;
+        if (!request.FindHeader(name, value)) {
+            throw std::invalid_argument("Missing request header: " + StdString(name));
+        }
+        if constexpr (std::is_same_v<Type, std::string_view>) {
+            return value;
+        } else if constexpr (std::is_same_v<Type, StdString> || std::is_same_v<Type, std::string>) {
+            return StdString(value);
+        } else if constexpr (std::is_integral_v<Type> && !std::is_same_v<Type, bool> &&
+                             !std::is_same_v<Type, char> && !std::is_same_v<Type, unsigned char>) {
+            Type result{};
+            auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+            if (error != std::errc() || end != value.data() + value.size()) {
+                throw std::invalid_argument("Invalid integer value for header " + StdString(name) + ": " + StdString(value));
+            }
+            return result;
+        } else {
+            return ConvertToType<Type>(StdString(value));
+        }
+    }
+
 };
 
 #endif // HTTP_REQUEST_DISPATCHER_H
\ No newline at end of file
@@ -5,10 +5,14 @@
 #include "IHttpRequestQueue.h"
 #include "IHttpRequestProcessor.h"
 #include "IHttpResponseProcessor.h"
-#include <ServerProvider.h>
+#include "BeanStartup.h"
+#include "RequestTracer.h"
+#include "ServerOverride.h"
+#include "HttpRequestManager.beans.h"
 
 /* @Component */
 class HttpRequestManager final : public IHttpRequestManager {
+    GeneratedBean(HttpRequestManager)
 
     /* @Autowired */
     Private IHttpRequestQueuePtr requestQueue;
@@ -22,7 +26,7 @@ class HttpRequestManager final : public IHttpRequestManager {
     Private IServerPtr server;
 
     Public HttpRequestManager() {
-        server = ServerProvider::GetDefaultServer();
+        server = ServerOverride::GetServer();
     }
     
     Public ~HttpRequestManager() override = default;
@@ -41,6 +45,8 @@ class HttpRequestManager final : public IHttpRequestManager {
             return false;
         }
         
+        RequestTracer::Begin(request->GetRequestId(), TraceStage::REQUEST_QUEUE);
+        AllocationStageScope allocationStage(TraceStage::REQUEST_QUEUE);
         requestQueue->EnqueueRequest(request);
         return true;
     }
@@ -85,6 +91,9 @@ class HttpRequestManager final : public IHttpRequestManager {
             return false;
         }
         
+        // Construct singletons up front so the first request does not pay for them
+        BeanStartup::Instance().Run();
+        
         Bool result = server->Start(port);
         
         return result;
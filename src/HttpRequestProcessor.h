@@ -6,9 +6,12 @@
 #include "IHttpRequestDispatcher.h"
 #include "IHttpResponseQueue.h"
 #include <IHttpResponse.h>
+#include "RequestTracer.h"
+#include "HttpRequestProcessor.beans.h"
 
 /* @Component */
 class HttpRequestProcessor final : public IHttpRequestProcessor {
+    GeneratedBean(HttpRequestProcessor)
 
     /* @Autowired */
     Private IHttpRequestQueuePtr requestQueue;
@@ -36,9 +39,13 @@ class HttpRequestProcessor final : public IHttpRequestProcessor {
         if (request == nullptr) {
             return false;
         }
+        RequestTracer::End(request->GetRequestId(), TraceStage::REQUEST_QUEUE);
         
         // Enqueue response into response queue
-        responseQueue->EnqueueResponse(dispatcher->DispatchRequest(request));
+        IHttpResponsePtr response = dispatcher->DispatchRequest(request);
+        RequestTracer::Begin(request->GetRequestId(), TraceStage::RESPONSE_QUEUE);
+        AllocationStageScope allocationStage(TraceStage::RESPONSE_QUEUE);
+        responseQueue->EnqueueResponse(response);
         
         return true;
     }
@@ -3,10 +3,15 @@
 
 #include "IHttpRequestQueue.h"
 #include <queue>
+#include <utility>
+#include "HttpRequestQueue.beans.h"
 
 /* @Component */
 class HttpRequestQueue final : public IHttpRequestQueue {
-    Private std::queue<IHttpRequestPtr> requestQueue;
+    GeneratedBean(HttpRequestQueue)
+    // Each request is queued with the time it was enqueued (QueueStats::NowMicros)
+    Private std::queue<std::pair<IHttpRequestPtr, uint64_t>> requestQueue;
+    Private QueueStats stats;
 
     Public HttpRequestQueue() = default;
     
@@ -21,7 +26,8 @@ class HttpRequestQueue final : public IHttpRequestQueue {
             return;
         }
         
-        requestQueue.push(request);
+        requestQueue.emplace(request, QueueStats::NowMicros());
+        stats.RecordEnqueue();
     }
     
     Public IHttpRequestPtr DequeueRequest() override {
@@ -29,7 +35,8 @@ class HttpRequestQueue final : public IHttpRequestQueue {
             return nullptr;
         }
         
-        IHttpRequestPtr request = requestQueue.front();
+        IHttpRequestPtr request = requestQueue.front().first;
+        stats.RecordDequeue(requestQueue.front().second);
         requestQueue.pop();
         return request;
     }
@@ -41,6 +48,14 @@ class HttpRequestQueue final : public IHttpRequestQueue {
     Public Bool HasRequests() const override {
         return !requestQueue.empty();
     }
+    
+    Public Size GetSize() const override {
+        return stats.GetSize();
+    }
+    
+    Public QueueStatsSnapshot GetStats() const override {
+        return stats.Snapshot();
+    }
 };
 
 #endif // HTTP_REQUEST_QUEUE_H
@@ -0,0 +1,174 @@
+#ifndef HTTP_REQUEST_VIEW_H
+#define HTTP_REQUEST_VIEW_H
+
+#include <StandardDefines.h>
+#include <string_view>
+#include "HttpHeaderIndex.h"
+
+/**
+ * HttpRequestView - non-owning view of the request being dispatched
+ *
+ * Path, query and body are std::string_view slices of the strings owned by
+ * the IHttpRequest (the server's receive buffer), and headers and path
+ * variables are referenced rather than copied. A view is only valid for the
+ * duration of HttpRequestDispatcher::DispatchRequest; handlers must copy
+ * anything they want to keep.
+ *
+ * Example usage (inside a generated handler):
+ *   Deserialize<UserDto>(request.GetBody());
+ *   HttpRequestDispatcher::ConvertToType<int>(request.GetPathVariable("id"));
+ */
+class HttpRequestView {
+    Private std::string_view requestId_;
+    Private std::string_view path_;
+    Private std::string_view query_;
+    Private std::string_view body_;
+    Private std::string_view pattern_;
+    Private const Map<StdString, StdString>* headers_;
+    Private const Map<StdString, StdString>* pathVariables_;
+    Private mutable HttpHeaderIndex headerIndex_;
+
+    Private Static const Map<StdString, StdString>& EmptyMap() {
+        static const Map<StdString, StdString> empty;
+        return empty;
+    }
+
+public:
+    /**
+     * Constructor
+     *
+     * @param requestId The request ID
+     * @param target The request target; anything after '?' becomes the query
+     * @param body The request body
+     * @param headers The request headers
+     */
+    HttpRequestView(std::string_view requestId, std::string_view target, std::string_view body,
+                    const Map<StdString, StdString>& headers)
+        : requestId_(requestId), path_(target), query_(), body_(body), pattern_(),
+          headers_(&headers), pathVariables_(&EmptyMap()) {
+        Size question = target.find('?');
+        if (question != std::string_view::npos) {
+            path_ = target.substr(0, question);
+            query_ = target.substr(question + 1);
+        }
+    }
+
+    /**
+     * Get the request ID
+     */
+    std::string_view GetRequestId() const {
+        return requestId_;
+    }
+
+    /**
+     * Get the path without the query string (e.g. "/api/user/42")
+     */
+    std::string_view GetPath() const {
+        return path_;
+    }
+
+    /**
+     * Get the raw query string without the leading '?' (e.g. "page=2&size=10")
+     */
+    std::string_view GetQuery() const {
+        return query_;
+    }
+
+    /**
+     * Get the request body
+     */
+    std::string_view GetBody() const {
+        return body_;
+    }
+
+    /**
+     * Get all headers
+     */
+    const Map<StdString, StdString>& GetHeaders() const {
+        return *headers_;
+    }
+
+    /**
+     * Find a header value by name (case-insensitive)
+     * The header index is built on the first lookup of the request.
+     *
+     * @param name Header name
+     * @param value Set to a view of the header value if found
+     * @return true if the header is present
+     */
+    Bool FindHeader(std::string_view name, std::string_view& value) const {
+        if (!headerIndex_.IsBuilt()) {
+            headerIndex_.Build(*headers_);
+        }
+        return headerIndex_.Find(name, value);
+    }
+
+    /**
+     * Get a header value by name (case-insensitive)
+     *
+     * @return The header value, or an empty view if the header is not present
+     */
+    std::string_view GetHeader(std::string_view name) const {
+        std::string_view value;
+        FindHeader(name, value);
+        return value;
+    }
+
+    /**
+     * Set the path variables extracted by the EndpointTrie
+     * The referenced map must outlive the view.
+     */
+    Void SetPathVariables(const Map<StdString, StdString>& variables) {
+        pathVariables_ = &variables;
+    }
+
+    /**
+     * Set the route pattern the path matched (e.g. "/api/user/{id}")
+     * The referenced string must outlive the view.
+     */
+    Void SetPattern(std::string_view pattern) {
+        pattern_ = pattern;
+    }
+
+    /**
+     * Get the route pattern the path matched, or an empty view before routing
+     */
+    std::string_view GetPattern() const {
+        return pattern_;
+    }
+
+    /**
+     * Get a path variable by name
+     *
+     * @return The raw (still URL-encoded) value, or an empty string if not present
+     */
+    CStdString& GetPathVariable(CStdString& name) const {
+        static CStdString empty;
+        auto it = pathVariables_->find(name);
+        if (it != pathVariables_->end()) {
+            return it->second;
+        }
+        return empty;
+    }
+
+    /**
+     * Get a path variable by its position in the matched pattern
+     * (index 1 of "/api/{group}/{id}" is "id")
+     *
+     * @return The raw (still URL-encoded) value, or an empty string if not present
+     */
+    CStdString& GetPathVariable(Size index) const {
+        static CStdString empty;
+        Size open = pattern_.find('{');
+        for (; open != std::string_view::npos && index > 0; --index) {
+            open = pattern_.find('{', open + 1);
+        }
+        Size close = open == std::string_view::npos ? open : pattern_.find('}', open);
+        if (close == std::string_view::npos) {
+            return empty;
+        }
+        return GetPathVariable(StdString(pattern_.substr(open + 1, close - open - 1)));
+    }
+};
+
+#endif // HTTP_REQUEST_VIEW_H
@@ -3,11 +3,14 @@
 
 #include "IHttpResponseProcessor.h"
 #include "IHttpResponseQueue.h"
-#include <ServerProvider.h>
+#include "ServerOverride.h"
 #include <IHttpResponse.h>
+#include "RequestTracer.h"
+#include "HttpResponseProcessor.beans.h"
 
 /* @Component */
 class HttpResponseProcessor final : public IHttpResponseProcessor {
+    GeneratedBean(HttpResponseProcessor)
 
     /* @Autowired */
     Private IHttpResponseQueuePtr responseQueue;
@@ -15,7 +18,7 @@ class HttpResponseProcessor final : public IHttpResponseProcessor {
     Private IServerPtr server;
 
     Public HttpResponseProcessor() 
-        : server(ServerProvider::GetDefaultServer()) {
+        : server(ServerOverride::GetServer()) {
     }
     
     Public ~HttpResponseProcessor() override = default;
@@ -43,6 +46,8 @@ class HttpResponseProcessor final : public IHttpResponseProcessor {
         if (requestId.empty()) {
             return false;
         }
+        RequestTracer::End(requestId, TraceStage::RESPONSE_QUEUE);
+        RequestTraceSpan send(requestId, TraceStage::SEND);
         
         // Convert response to HTTP string format
         StdString responseString = response->ToHttpString();
@@ -3,10 +3,15 @@
 
 #include "IHttpResponseQueue.h"
 #include <queue>
+#include <utility>
+#include "HttpResponseQueue.beans.h"
 
 /* @Component */
 class HttpResponseQueue final : public IHttpResponseQueue {
-    Private std::queue<IHttpResponsePtr> responseQueue;
+    GeneratedBean(HttpResponseQueue)
+    // Each response is queued with the time it was enqueued (QueueStats::NowMicros)
+    Private std::queue<std::pair<IHttpResponsePtr, uint64_t>> responseQueue;
+    Private QueueStats stats;
 
     Public HttpResponseQueue() = default;
     
@@ -21,7 +26,8 @@ class HttpResponseQueue final : public IHttpResponseQueue {
             return;
         }
         
-        responseQueue.push(response);
+        responseQueue.emplace(response, QueueStats::NowMicros());
+        stats.RecordEnqueue();
     }
     
     Public IHttpResponsePtr DequeueResponse() override {
@@ -29,7 +35,8 @@ class HttpResponseQueue final : public IHttpResponseQueue {
             return nullptr;
         }
         
-        IHttpResponsePtr response = responseQueue.front();
+        IHttpResponsePtr response = responseQueue.front().first;
+        stats.RecordDequeue(responseQueue.front().second);
         responseQueue.pop();
         return response;
     }
@@ -41,6 +48,14 @@ class HttpResponseQueue final : public IHttpResponseQueue {
     Public Bool HasResponses() const override {
         return !responseQueue.empty();
     }
+    
+    Public Size GetSize() const override {
+        return stats.GetSize();
+    }
+    
+    Public QueueStatsSnapshot GetStats() const override {
+        return stats.Snapshot();
+    }
 };
 
 #endif // HTTP_RESPONSE_QUEUE_H
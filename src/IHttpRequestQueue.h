@@ -3,6 +3,7 @@
 
 #include <StandardDefines.h>
 #include <IHttpRequest.h>
+#include "QueueStats.h"
 
 // Forward declarations
 DefineStandardPointers(IHttpRequestQueue)
@@ -37,6 +38,18 @@ class IHttpRequestQueue {
      * @return true if queue has items, false if empty
      */
     Public Virtual Bool HasRequests() const = 0;
+    
+    /**
+     * @brief Number of requests currently queued
+     */
+    Public Virtual Size GetSize() const = 0;
+    
+    /**
+     * @brief Size, high-water mark, cumulative enqueue/dequeue counts and time-in-queue histogram
+     * Rates are computed from two snapshots (QueueStatsSnapshot::DequeueRateSince).
+     * @return Snapshot of the queue statistics
+     */
+    Public Virtual QueueStatsSnapshot GetStats() const = 0;
 };
 
 #endif // I_HTTP_REQUEST_QUEUE_H
@@ -3,6 +3,7 @@
 
 #include <StandardDefines.h>
 #include <IHttpResponse.h>
+#include "QueueStats.h"
 
 // Forward declarations
 DefineStandardPointers(IHttpResponseQueue)
@@ -37,6 +38,18 @@ class IHttpResponseQueue {
      * @return true if queue has items, false if empty
      */
     Public Virtual Bool HasResponses() const = 0;
+    
+    /**
+     * @brief Number of responses currently queued
+     */
+    Public Virtual Size GetSize() const = 0;
+    
+    /**
+     * @brief Size, high-water mark, cumulative enqueue/dequeue counts and time-in-queue histogram
+     * Rates are computed from two snapshots (QueueStatsSnapshot::DequeueRateSince).
+     * @return Snapshot of the queue statistics
+     */
+    Public Virtual QueueStatsSnapshot GetStats() const = 0;
 };
 
 #endif // I_HTTP_RESPONSE_QUEUE_H
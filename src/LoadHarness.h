@@ -0,0 +1,338 @@
+#ifndef LOAD_HARNESS_H
+#define LOAD_HARNESS_H
+
+#include <StandardDefines.h>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <iomanip>
+#include "IHttpRequestManager.h"
+#include "LoopbackServer.h"
+#include "AllocationCounter.h"
+
+/**
+ * LoadHarness - in-process end-to-end load test of the request pipeline
+ *
+ * Drives HttpRequestManager (request queue, processor, dispatcher, response
+ * queue, response processor) against a LoopbackServer, so pipeline changes
+ * can be compared on a desktop build without sockets. Requests are generated
+ * either open-loop (Poisson arrivals at a fixed rate) or closed-loop (N
+ * clients, each waiting for its response plus a think time before sending
+ * the next one).
+ *
+ * Latency is measured from the scheduled send time to the response reaching
+ * LoopbackServer::SendMessage(). In open-loop mode requests that could not be
+ * injected on time still count from their scheduled time, so a stalled
+ * pipeline shows up in the percentiles instead of lowering the offered load.
+ *
+ * Example usage (desktop build):
+ *   LoopbackServerPtr server = std::make_shared<LoopbackServer>();
+ *   ServerOverride::Set(server);   // before the manager bean is created
+ *   LoadHarness harness(server, Implementation<IHttpRequestManager>::type::GetInstance());
+ *   harness.AddRoute(LoadRoute{"get user", HttpMethod::GET, "/api/user/42"});
+ *   LoadConfig config;
+ *   config.requestsPerSecond = 20000;
+ *   harness.Run(config).Print();
+ *
+ * With HTTP_ENABLE_ALLOCATION_COUNTING, MeasureAllocations() reports the heap
+ * allocations per request of one route by pipeline stage, for allocation
+ * budgets in benchmarks and consumer tests (see AllocationCounter.h).
+ */
+
+enum class ArrivalMode {
+    OPEN_LOOP_POISSON,
+    CLOSED_LOOP
+};
+
+/**
+ * Request template sent by the harness
+ */
+struct LoadRoute {
+    StdString name;
+    HttpMethod method;
+    StdString path;
+    StdString body;
+    Map<StdString, StdString> headers;
+    UInt weight = 1;
+};
+
+struct LoadConfig {
+    ArrivalMode mode = ArrivalMode::OPEN_LOOP_POISSON;
+    // Open loop: mean arrival rate
+    double requestsPerSecond = 1000.0;
+    // Closed loop: concurrent clients and the pause between response and next request
+    UInt clients = 1;
+    ULong thinkTimeMicros = 0;
+    // Requests scheduled during warmup are sent but not recorded
+    ULong warmupMillis = 500;
+    ULong durationMillis = 5000;
+    // Time allowed after the run for outstanding responses
+    ULong drainMillis = 1000;
+    UInt seed = 1;
+};
+
+struct RouteLoadStats {
+    StdString name;
+    Size requests = 0;
+    Size errors = 0;
+    double requestsPerSecond = 0.0;
+    double p50Micros = 0.0;
+    double p99Micros = 0.0;
+    double p999Micros = 0.0;
+    double maxMicros = 0.0;
+};
+
+struct LoadReport {
+    double seconds = 0.0;
+    Size requests = 0;
+    Size errors = 0;
+    // Requests with no response by the end of the drain period
+    Size unanswered = 0;
+    Vector<RouteLoadStats> routes;
+
+    Void Print(std::ostream& out = std::cout) const {
+        out << std::fixed << std::setprecision(2);
+        out << "requests " << requests << " in " << seconds << " s (" << (seconds > 0 ? requests / seconds : 0.0)
+            << " req/s), errors " << errors << ", unanswered " << unanswered << std::endl;
+        out << std::left << std::setw(24) << "route" << std::right << std::setw(10) << "count" << std::setw(12) << "req/s"
+            << std::setw(10) << "errors" << std::setw(12) << "p50 us" << std::setw(12) << "p99 us"
+            << std::setw(12) << "p999 us" << std::setw(12) << "max us" << std::endl;
+        for (const RouteLoadStats& route : routes) {
+            out << std::left << std::setw(24) << route.name << std::right << std::setw(10) << route.requests
+                << std::setw(12) << route.requestsPerSecond << std::setw(10) << route.errors
+                << std::setw(12) << route.p50Micros << std::setw(12) << route.p99Micros
+                << std::setw(12) << route.p999Micros << std::setw(12) << route.maxMicros << std::endl;
+        }
+    }
+};
+
+class LoadHarness {
+    using Clock = std::chrono::steady_clock;
+
+    Private struct Outstanding {
+        Size route;
+        Size client;
+        Clock::time_point scheduledAt;
+    };
+
+    Private struct Client {
+        Bool busy = false;
+        Clock::time_point nextSendAt;
+    };
+
+    Private LoopbackServerPtr server_;
+    Private IHttpRequestManagerPtr manager_;
+    Private Vector<LoadRoute> routes_;
+
+    Public LoadHarness(LoopbackServerPtr server, IHttpRequestManagerPtr manager)
+        : server_(server), manager_(manager) {
+    }
+
+    /**
+     * Add a request template; routes are picked at random in proportion to their weight
+     */
+    Public Void AddRoute(const LoadRoute& route) {
+        routes_.push_back(route);
+        if (routes_.back().name.empty()) {
+            routes_.back().name = routes_.back().path;
+        }
+    }
+
+    /**
+     * Run one load test and report per-route throughput and latency percentiles
+     */
+    Public LoadReport Run(const LoadConfig& config) {
+        LoadReport report;
+        if (routes_.empty() || server_ == nullptr || manager_ == nullptr) {
+            return report;
+        }
+        manager_->StartServer();
+
+        std::mt19937_64 random(config.seed);
+        Vector<double> weights;
+        for (const LoadRoute& route : routes_) {
+            weights.push_back(route.weight);
+        }
+        std::discrete_distribution<Size> pickRoute(weights.begin(), weights.end());
+        std::exponential_distribution<double> interArrival(config.requestsPerSecond > 0 ? config.requestsPerSecond : 1.0);
+
+        // Per-route latency samples in nanoseconds
+        Vector<Vector<ULong>> latencies(routes_.size());
+        Vector<Size> errors(routes_.size(), 0);
+        UnorderedMap<StdString, Outstanding> outstanding;
+        Vector<LoopbackServer::Completion> completions;
+        Size sequence = 0;
+
+        Clock::time_point start = Clock::now();
+        Clock::time_point measureFrom = start + std::chrono::milliseconds(config.warmupMillis);
+        Clock::time_point end = measureFrom + std::chrono::milliseconds(config.durationMillis);
+        Clock::time_point drainUntil = end + std::chrono::milliseconds(config.drainMillis);
+
+        auto send = [&](Size client, Clock::time_point scheduledAt) {
+            Size route = pickRoute(random);
+            const LoadRoute& request = routes_[route];
+            StdString requestId = "load-" + std::to_string(++sequence);
+            outstanding[requestId] = Outstanding{route, client, scheduledAt};
+            server_->Inject(std::make_shared<LoopbackRequest>(requestId, request.method, request.path,
+                                                              request.body, request.headers));
+        };
+
+        Vector<Client> clients(config.mode == ArrivalMode::CLOSED_LOOP ? config.clients : 0);
+        for (Client& client : clients) {
+            client.nextSendAt = start;
+        }
+        Clock::time_point nextArrival = start + ToDuration(interArrival(random));
+
+        while (true) {
+            Clock::time_point now = Clock::now();
+            if (now >= drainUntil || (now >= end && outstanding.empty())) {
+                break;
+            }
+
+            // Issue everything that is due
+            if (config.mode == ArrivalMode::OPEN_LOOP_POISSON) {
+                while (nextArrival <= now && nextArrival < end) {
+                    send(0, nextArrival);
+                    nextArrival += ToDuration(interArrival(random));
+                }
+            } else if (now < end) {
+                for (Size i = 0; i < clients.size(); ++i) {
+                    if (!clients[i].busy && clients[i].nextSendAt <= now) {
+                        clients[i].busy = true;
+                        send(i, now);
+                    }
+                }
+            }
+
+            // One iteration of the application's request/response loop
+            while (manager_->RetrieveRequest()) {
+            }
+            manager_->ProcessRequest();
+            manager_->ProcessResponse();
+
+            server_->DrainCompletions(completions);
+            for (const LoopbackServer::Completion& completion : completions) {
+                auto it = outstanding.find(completion.requestId);
+                if (it == outstanding.end()) {
+                    continue;
+                }
+                const Outstanding& request = it->second;
+                if (request.scheduledAt >= measureFrom && request.scheduledAt < end) {
+                    latencies[request.route].push_back(static_cast<ULong>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(completion.sentAt - request.scheduledAt).count()));
+                    if (ParseStatus(completion.response) >= 400) {
+                        ++errors[request.route];
+                    }
+                }
+                if (config.mode == ArrivalMode::CLOSED_LOOP) {
+                    clients[request.client].busy = false;
+                    clients[request.client].nextSendAt = completion.sentAt + std::chrono::microseconds(config.thinkTimeMicros);
+                }
+                outstanding.erase(it);
+            }
+        }
+
+        report.seconds = config.durationMillis / 1000.0;
+        report.unanswered = outstanding.size();
+        for (Size i = 0; i < routes_.size(); ++i) {
+            RouteLoadStats stats = Summarize(routes_[i].name, latencies[i], report.seconds);
+            stats.errors = errors[i];
+            report.requests += stats.requests;
+            report.errors += stats.errors;
+            report.routes.push_back(stats);
+        }
+        return report;
+    }
+
+    /**
+     * Average allocations per request of one route, sent one at a time
+     * One request is sent first and not counted, so lazily built state (header
+     * indexes, caches, queue capacity) does not count against the route.
+     * Counts cover the pipeline from IHttpRequestManager::RetrieveRequest()
+     * onwards; building and injecting the LoopbackRequest is not included, and
+     * the send stage includes LoopbackServer keeping a copy of the response.
+     * Returns an empty snapshot without HTTP_ENABLE_ALLOCATION_COUNTING.
+     */
+    Public AllocationSnapshot MeasureAllocations(Size route, UInt requests = 100) {
+        if (route >= routes_.size() || server_ == nullptr || manager_ == nullptr || requests == 0) {
+            return AllocationSnapshot();
+        }
+        manager_->StartServer();
+        const LoadRoute& request = routes_[route];
+        Vector<LoopbackServer::Completion> completions;
+        completions.reserve(1);
+        AllocationSnapshot total;
+        for (UInt i = 0; i <= requests; ++i) {
+            server_->Inject(std::make_shared<LoopbackRequest>("alloc-" + std::to_string(i), request.method,
+                                                              request.path, request.body, request.headers));
+            AllocationSnapshot before = AllocationCounter::Snapshot();
+            while (manager_->RetrieveRequest()) {
+            }
+            manager_->ProcessRequest();
+            manager_->ProcessResponse();
+            AllocationSnapshot delta = AllocationCounter::Snapshot().Since(before);
+            server_->DrainCompletions(completions);
+            if (i == 0) {
+                continue;
+            }
+            for (Size stage = 0; stage < TRACE_STAGE_COUNT; ++stage) {
+                total.stages[stage].allocations += delta.stages[stage].allocations;
+                total.stages[stage].bytes += delta.stages[stage].bytes;
+            }
+            total.unattributed.allocations += delta.unattributed.allocations;
+            total.unattributed.bytes += delta.unattributed.bytes;
+        }
+        return total.PerRequest(requests);
+    }
+
+    Private Static Clock::duration ToDuration(double seconds) {
+        return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+    }
+
+    /**
+     * Status code from the response status line ("HTTP/1.1 404 Not Found" or "404 Not Found")
+     */
+    Private Static Int ParseStatus(CStdString& response) {
+        Size position = response.compare(0, 5, "HTTP/") == 0 ? response.find(' ') : 0;
+        if (position == StdString::npos) {
+            return 0;
+        }
+        while (position < response.length() && response[position] == ' ') {
+            ++position;
+        }
+        Int status = 0;
+        for (Size i = position; i < response.length() && i < position + 3 && std::isdigit(static_cast<UChar>(response[i])); ++i) {
+            status = status * 10 + (response[i] - '0');
+        }
+        return status;
+    }
+
+    /**
+     * Nearest-rank percentile of sorted nanosecond samples, in microseconds
+     */
+    Private Static double PercentileMicros(const Vector<ULong>& sorted, double fraction) {
+        if (sorted.empty()) {
+            return 0.0;
+        }
+        Size rank = static_cast<Size>(fraction * sorted.size() + 0.999999);
+        rank = rank == 0 ? 1 : std::min(rank, sorted.size());
+        return sorted[rank - 1] / 1000.0;
+    }
+
+    Private Static RouteLoadStats Summarize(CStdString& name, Vector<ULong>& latencies, double seconds) {
+        std::sort(latencies.begin(), latencies.end());
+        RouteLoadStats stats;
+        stats.name = name;
+        stats.requests = latencies.size();
+        stats.requestsPerSecond = seconds > 0 ? latencies.size() / seconds : 0.0;
+        stats.p50Micros = PercentileMicros(latencies, 0.50);
+        stats.p99Micros = PercentileMicros(latencies, 0.99);
+        stats.p999Micros = PercentileMicros(latencies, 0.999);
+        stats.maxMicros = latencies.empty() ? 0.0 : latencies.back() / 1000.0;
+        return stats;
+    }
+};
+
+#endif // LOAD_HARNESS_H
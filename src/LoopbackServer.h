@@ -0,0 +1,128 @@
+#ifndef LOOPBACK_SERVER_H
+#define LOOPBACK_SERVER_H
+
+#include <StandardDefines.h>
+#include <IServer.h>
+#include <IHttpRequest.h>
+#include <chrono>
+#include <deque>
+
+/**
+ * LoopbackServer - in-process IServer without sockets
+ *
+ * Requests are injected by the caller (usually LoadHarness) and handed to
+ * HttpRequestManager through ReceiveMessage(); responses written with
+ * SendMessage() are kept, with the time they were sent, until the caller
+ * drains them. Install it with ServerOverride::Set() so the request manager
+ * and response processor use it instead of the default server.
+ *
+ * Like the request and response queues, the server is not synchronized: it
+ * is driven from the single request/response loop.
+ */
+
+/**
+ * Request injected into a LoopbackServer
+ */
+class LoopbackRequest final : public IHttpRequest {
+    Private StdString requestId_;
+    Private HttpMethod method_;
+    Private StdString path_;
+    Private StdString body_;
+    Private Map<StdString, StdString> headers_;
+
+    Public LoopbackRequest(CStdString& requestId, HttpMethod method, CStdString& path, CStdString& body,
+                           const Map<StdString, StdString>& headers)
+        : requestId_(requestId), method_(method), path_(path), body_(body), headers_(headers) {
+    }
+
+    Public CStdString& GetRequestId() const override {
+        return requestId_;
+    }
+
+    Public HttpMethod GetMethod() const override {
+        return method_;
+    }
+
+    Public CStdString& GetPath() const override {
+        return path_;
+    }
+
+    Public CStdString& GetBody() const override {
+        return body_;
+    }
+
+    Public const Map<StdString, StdString>& GetHeaders() const override {
+        return headers_;
+    }
+};
+
+DefineStandardPointers(LoopbackServer)
+class LoopbackServer final : public IServer {
+    /**
+     * Response written by the pipeline for one request
+     */
+    Public struct Completion {
+        StdString requestId;
+        StdString response;
+        std::chrono::steady_clock::time_point sentAt;
+    };
+
+    Private std::deque<IHttpRequestPtr> inbox_;
+    Private Vector<Completion> completions_;
+    Private Bool running_ = false;
+
+    // ============================================================================
+    // Loopback Operations
+    // ============================================================================
+
+    /**
+     * Queue a request to be returned by the next ReceiveMessage()
+     */
+    Public Void Inject(IHttpRequestPtr request) {
+        inbox_.push_back(request);
+    }
+
+    /**
+     * Number of injected requests not yet received by the pipeline
+     */
+    Public Size Pending() const {
+        return inbox_.size();
+    }
+
+    /**
+     * Move all responses sent since the last call into completions
+     */
+    Public Void DrainCompletions(Vector<Completion>& completions) {
+        completions.clear();
+        completions.swap(completions_);
+    }
+
+    // ============================================================================
+    // IServer
+    // ============================================================================
+
+    Public IHttpRequestPtr ReceiveMessage() override {
+        if (!running_ || inbox_.empty()) {
+            return nullptr;
+        }
+        IHttpRequestPtr request = inbox_.front();
+        inbox_.pop_front();
+        return request;
+    }
+
+    Public Bool SendMessage(CStdString& requestId, CStdString& response) override {
+        completions_.push_back(Completion{requestId, response, std::chrono::steady_clock::now()});
+        return true;
+    }
+
+    Public Bool Start(CUInt /*port*/) override {
+        running_ = true;
+        return true;
+    }
+
+    Public Void Stop() override {
+        running_ = false;
+    }
+};
+
+#endif // LOOPBACK_SERVER_H
@@ -0,0 +1,155 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <StandardDefines.h>
+#include <cstddef>
+#include <memory>
+#include <new>
+
+/**
+ * Maximum number of free blocks each pool keeps for reuse
+ * Blocks returned beyond this go back to the global allocator.
+ * Define HTTP_DISABLE_OBJECT_POOL to allocate every object from the heap.
+ */
+#ifndef HTTP_OBJECT_POOL_CAPACITY
+#define HTTP_OBJECT_POOL_CAPACITY 16
+#endif
+
+/**
+ * FixedBlockPool - free list of equally sized memory blocks
+ *
+ * One pool exists per block size / alignment pair. Blocks are handed out from
+ * the free list and pushed back on release, so steady-state traffic does not
+ * touch the global allocator. Like the request and response queues, the pool
+ * is not synchronized: it is used from the single request/response loop.
+ * Callers that need their own (e.g. lock-guarded) pools pass a distinct Tag.
+ */
+template<Size BlockSize, Size BlockAlignment, typename Tag = Void>
+class FixedBlockPool {
+    Private struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static_assert(BlockSize >= sizeof(FreeBlock), "Pool blocks must be able to hold a free-list link");
+    static_assert(BlockAlignment <= alignof(std::max_align_t), "Over-aligned types are not supported by the pool");
+
+    Private FreeBlock* freeList_;
+    Private Size freeCount_;
+
+    Private FixedBlockPool() : freeList_(nullptr), freeCount_(0) {
+    }
+
+public:
+    FixedBlockPool(const FixedBlockPool&) = delete;
+    FixedBlockPool& operator=(const FixedBlockPool&) = delete;
+
+    ~FixedBlockPool() {
+        while (freeList_ != nullptr) {
+            FreeBlock* block = freeList_;
+            freeList_ = block->next;
+            ::operator delete(block);
+        }
+    }
+
+    /**
+     * Get the pool shared by all objects of this block size
+     */
+    Static FixedBlockPool& Instance() {
+        static FixedBlockPool pool;
+        return pool;
+    }
+
+    /**
+     * Take a block from the free list, or from the heap if the list is empty
+     */
+    Void* Allocate() {
+        if (freeList_ != nullptr) {
+            FreeBlock* block = freeList_;
+            freeList_ = block->next;
+            --freeCount_;
+            return block;
+        }
+        return ::operator new(BlockSize);
+    }
+
+    /**
+     * Return a block to the free list (or the heap once the list is full)
+     */
+    Void Deallocate(Void* pointer) {
+        if (freeCount_ >= HTTP_OBJECT_POOL_CAPACITY) {
+            ::operator delete(pointer);
+            return;
+        }
+        FreeBlock* block = static_cast<FreeBlock*>(pointer);
+        block->next = freeList_;
+        freeList_ = block;
+        ++freeCount_;
+    }
+
+    /**
+     * Number of blocks currently cached for reuse
+     */
+    Size GetFreeCount() const {
+        return freeCount_;
+    }
+};
+
+/**
+ * PoolAllocator - standard allocator backed by FixedBlockPool
+ *
+ * Intended for std::allocate_shared: the shared_ptr control block and the
+ * object are allocated together as one pooled block, and returned to the pool
+ * when the last reference goes away (the object is destroyed, so the next
+ * user always gets a freshly constructed instance).
+ */
+template<typename T>
+class PoolAllocator {
+public:
+    typedef T value_type;
+
+    PoolAllocator() noexcept = default;
+
+    template<typename U>
+    PoolAllocator(const PoolAllocator<U>&) noexcept {
+    }
+
+    T* allocate(Size count) {
+        if (count != 1) {
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        return static_cast<T*>(FixedBlockPool<sizeof(T), alignof(T)>::Instance().Allocate());
+    }
+
+    Void deallocate(T* pointer, Size count) noexcept {
+        if (count != 1) {
+            ::operator delete(pointer);
+            return;
+        }
+        FixedBlockPool<sizeof(T), alignof(T)>::Instance().Deallocate(pointer);
+    }
+
+    template<typename U>
+    Bool operator==(const PoolAllocator<U>&) const noexcept {
+        return true;
+    }
+
+    template<typename U>
+    Bool operator!=(const PoolAllocator<U>&) const noexcept {
+        return false;
+    }
+};
+
+/**
+ * Create a shared object whose storage comes from the object pool
+ * Drop-in replacement for make_ptr<T>(args...).
+ */
+template<typename T, typename... Args>
+inline std::shared_ptr<T> make_pooled_ptr(Args&&... args) {
+#ifdef HTTP_DISABLE_OBJECT_POOL
+    return make_ptr<T>(std::forward<Args>(args)...);
+#else
+    return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+#endif
+}
+
+#endif // OBJECT_POOL_H
@@ -0,0 +1,34 @@
+#ifndef PIPELINE_STAGE_H
+#define PIPELINE_STAGE_H
+
+#include <StandardDefines.h>
+
+/**
+ * Stages of the request pipeline, shared by RequestTracer and AllocationCounter
+ */
+enum class TraceStage : UInt8 {
+    REQUEST_QUEUE,
+    DISPATCH,
+    ROUTING,
+    HANDLER,
+    SERIALIZATION,
+    RESPONSE_QUEUE,
+    SEND
+};
+
+Static constexpr Size TRACE_STAGE_COUNT = 7;
+
+inline const char* TraceStageName(TraceStage stage) {
+    switch (stage) {
+        case TraceStage::REQUEST_QUEUE: return "request-queue";
+        case TraceStage::DISPATCH: return "dispatch";
+        case TraceStage::ROUTING: return "routing";
+        case TraceStage::HANDLER: return "handler";
+        case TraceStage::SERIALIZATION: return "serialization";
+        case TraceStage::RESPONSE_QUEUE: return "response-queue";
+        case TraceStage::SEND: return "send";
+    }
+    return "unknown";
+}
+
+#endif // PIPELINE_STAGE_H
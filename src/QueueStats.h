@@ -0,0 +1,195 @@
+#ifndef QUEUE_STATS_H
+#define QUEUE_STATS_H
+
+#include <StandardDefines.h>
+#include <atomic>
+#include <cstdint>
+
+#ifdef ARDUINO
+    #include <Arduino.h>
+#else
+    #include <chrono>
+#endif
+
+/**
+ * Number of time-in-queue histogram buckets
+ * Bucket 0 counts waits below 1us, bucket i waits in [2^(i-1), 2^i) us, and
+ * the last bucket everything longer (2^(N-2) us, ~4 s with the default 24).
+ */
+#ifndef HTTP_QUEUE_WAIT_BUCKETS
+#define HTTP_QUEUE_WAIT_BUCKETS 24
+#endif
+
+/**
+ * Point-in-time copy of a queue's statistics
+ */
+struct QueueStatsSnapshot {
+    Size size = 0;
+    Size highWaterMark = 0;
+    // Cumulative since the queue was created
+    uint64_t enqueued = 0;
+    uint64_t dequeued = 0;
+    // QueueStats::NowMicros() when the snapshot was taken
+    uint64_t timestampMicros = 0;
+    // Time-in-queue histogram, see HTTP_QUEUE_WAIT_BUCKETS
+    uint64_t waitBuckets[HTTP_QUEUE_WAIT_BUCKETS] = {};
+
+    /**
+     * Items enqueued per second between an earlier snapshot and this one
+     * Each reader keeps its own earlier snapshot, so readers do not disturb each other.
+     */
+    double EnqueueRateSince(const QueueStatsSnapshot& earlier) const {
+        return RateSince(enqueued, earlier.enqueued, earlier.timestampMicros);
+    }
+
+    /**
+     * Items dequeued per second between an earlier snapshot and this one
+     */
+    double DequeueRateSince(const QueueStatsSnapshot& earlier) const {
+        return RateSince(dequeued, earlier.dequeued, earlier.timestampMicros);
+    }
+
+    /**
+     * Upper bound of the bucket holding the given fraction (0..1) of waits, in microseconds
+     */
+    uint64_t WaitPercentileMicros(double fraction) const {
+        uint64_t total = 0;
+        for (uint64_t count : waitBuckets) {
+            total += count;
+        }
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t target = static_cast<uint64_t>(fraction * total);
+        target = target == 0 ? 1 : target;
+        uint64_t cumulative = 0;
+        for (Size i = 0; i < HTTP_QUEUE_WAIT_BUCKETS; ++i) {
+            cumulative += waitBuckets[i];
+            if (cumulative >= target) {
+                return uint64_t(1) << i;
+            }
+        }
+        return uint64_t(1) << (HTTP_QUEUE_WAIT_BUCKETS - 1);
+    }
+
+    double RateSince(uint64_t count, uint64_t earlierCount, uint64_t earlierMicros) const {
+        if (timestampMicros <= earlierMicros || count < earlierCount) {
+            return 0.0;
+        }
+        return (count - earlierCount) * 1e6 / (timestampMicros - earlierMicros);
+    }
+
+    /**
+     * JSON object for metrics export
+     * e.g. {"size":0,"highWaterMark":12,...,"waitBucketsMicros":[0,4,...]}
+     */
+    StdString ToJson() const {
+        StdString json = "{\"size\":" + std::to_string(size) +
+                         ",\"highWaterMark\":" + std::to_string(highWaterMark) +
+                         ",\"enqueued\":" + std::to_string(enqueued) +
+                         ",\"dequeued\":" + std::to_string(dequeued) +
+                         ",\"timestampMicros\":" + std::to_string(timestampMicros) +
+                         ",\"waitP50Micros\":" + std::to_string(WaitPercentileMicros(0.50)) +
+                         ",\"waitP99Micros\":" + std::to_string(WaitPercentileMicros(0.99)) +
+                         ",\"waitBucketsMicros\":[";
+        for (Size i = 0; i < HTTP_QUEUE_WAIT_BUCKETS; ++i) {
+            json += (i == 0 ? "" : ",") + std::to_string(waitBuckets[i]);
+        }
+        json += "]}";
+        return json;
+    }
+};
+
+/**
+ * QueueStats - counters kept by the request and response queues
+ *
+ * All counters are relaxed atomics: the queues update them from the
+ * request/response loop and a metrics reader may snapshot them from another
+ * thread without locking. A snapshot is therefore only approximately
+ * consistent across fields, which is fine for sizing pools and limits.
+ * Snapshots only read: counters are cumulative and stamped with the time, and
+ * rates are computed by the reader from two of its own snapshots.
+ *
+ * Example usage (metrics exporter):
+ *   QueueStatsSnapshot now = queue->GetStats();
+ *   double perSecond = now.DequeueRateSince(previous);
+ *   previous = now;
+ */
+class QueueStats {
+    Private std::atomic<Size> size_{0};
+    Private std::atomic<Size> highWaterMark_{0};
+    Private std::atomic<uint64_t> enqueued_{0};
+    Private std::atomic<uint64_t> dequeued_{0};
+    Private std::atomic<uint64_t> waitBuckets_[HTTP_QUEUE_WAIT_BUCKETS] = {};
+
+    Private Static Size WaitBucket(uint64_t micros) {
+        Size bucket = 0;
+        while (micros > 0 && bucket < HTTP_QUEUE_WAIT_BUCKETS - 1) {
+            micros >>= 1;
+            ++bucket;
+        }
+        return bucket;
+    }
+
+public:
+    /**
+     * Monotonic time in microseconds, used to stamp queued items
+     */
+    Static uint64_t NowMicros() {
+#ifdef ARDUINO
+        return micros();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    Void RecordEnqueue() {
+        enqueued_.fetch_add(1, std::memory_order_relaxed);
+        Size size = size_.fetch_add(1, std::memory_order_relaxed) + 1;
+        Size highWaterMark = highWaterMark_.load(std::memory_order_relaxed);
+        while (size > highWaterMark &&
+               !highWaterMark_.compare_exchange_weak(highWaterMark, size, std::memory_order_relaxed)) {
+        }
+    }
+
+    /**
+     * @param enqueuedAtMicros NowMicros() when the item was enqueued
+     */
+    Void RecordDequeue(uint64_t enqueuedAtMicros) {
+        dequeued_.fetch_add(1, std::memory_order_relaxed);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        uint64_t now = NowMicros();
+        uint64_t waited = now > enqueuedAtMicros ? now - enqueuedAtMicros : 0;
+        waitBuckets_[WaitBucket(waited)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    Size GetSize() const {
+        return size_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Copy the counters and stamp the copy with the current time
+     */
+    QueueStatsSnapshot Snapshot() const {
+        QueueStatsSnapshot snapshot;
+        snapshot.timestampMicros = NowMicros();
+        snapshot.size = size_.load(std::memory_order_relaxed);
+        snapshot.highWaterMark = highWaterMark_.load(std::memory_order_relaxed);
+        snapshot.enqueued = enqueued_.load(std::memory_order_relaxed);
+        snapshot.dequeued = dequeued_.load(std::memory_order_relaxed);
+        for (Size i = 0; i < HTTP_QUEUE_WAIT_BUCKETS; ++i) {
+            snapshot.waitBuckets[i] = waitBuckets_[i].load(std::memory_order_relaxed);
+        }
+        return snapshot;
+    }
+
+    /**
+     * Restart the high-water mark from the current size
+     */
+    Void ResetHighWaterMark() {
+        highWaterMark_.store(size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+};
+
+#endif // QUEUE_STATS_H
@@ -0,0 +1,120 @@
+#ifndef RAW_BODY_H
+#define RAW_BODY_H
+
+#include "StandardDefines.h"
+#include <string_view>
+#include <type_traits>
+
+/**
+ * RawBody - response body written to the wire verbatim
+ *
+ * Use for payloads that are already in their final encoding: images, firmware
+ * chunks, pre-rendered JSON. The bytes are never passed through
+ * SerializationUtility and never escaped; the Content-Type is whatever the
+ * caller says it is.
+ *
+ * A RawBody either owns its bytes (moved in from a StdString) or is a view over
+ * bytes owned elsewhere (static tables, flash-resident assets, caches). A view
+ * must outlive the response conversion; nothing is copied until the bytes are
+ * placed into the outgoing response.
+ *
+ * Example usage:
+ *   ResponseEntity<RawBody> image = ResponseEntity<RawBody>::Ok(RawBody(std::move(png), "image/png"));
+ *   ResponseEntity<RawBody> cached = ResponseEntity<RawBody>::Ok(RawBody::View(kIndexJson, "application/json"));
+ */
+class RawBody {
+    Private StdString ownedBytes_;
+    Private std::string_view viewBytes_;
+    Private Bool isView_;
+    Private StdString contentType_;
+
+    /**
+     * Default constructor - empty octet-stream body
+     */
+    Public RawBody()
+        : ownedBytes_(), viewBytes_(), isView_(false), contentType_("application/octet-stream") {
+    }
+
+    /**
+     * Constructor taking ownership of the bytes
+     *
+     * @param bytes The payload (moved in)
+     * @param contentType The Content-Type to send with the payload
+     */
+    Public RawBody(StdString bytes, CStdString& contentType = "application/octet-stream")
+        : ownedBytes_(std::move(bytes)), viewBytes_(), isView_(false), contentType_(contentType) {
+    }
+
+    /**
+     * Create a RawBody that refers to bytes owned elsewhere
+     *
+     * @param bytes The payload; must stay alive until the response is built
+     * @param contentType The Content-Type to send with the payload
+     * @return Non-owning RawBody
+     */
+    Public Static RawBody View(std::string_view bytes, CStdString& contentType = "application/octet-stream") {
+        RawBody body;
+        body.viewBytes_ = bytes;
+        body.isView_ = true;
+        body.contentType_ = contentType;
+        return body;
+    }
+
+    /**
+     * Get the payload bytes
+     */
+    Public std::string_view GetBytes() const {
+        return isView_ ? viewBytes_ : std::string_view(ownedBytes_);
+    }
+
+    /**
+     * Get the Content-Type of the payload
+     */
+    Public CStdString& GetContentType() const {
+        return contentType_;
+    }
+
+    /**
+     * Check if this RawBody is a non-owning view
+     */
+    Public Bool IsView() const {
+        return isView_;
+    }
+};
+
+/**
+ * Type trait to check if a body type is written to the wire verbatim
+ */
+template<typename T>
+struct is_raw_body_type {
+    static constexpr bool value = std::is_same_v<T, RawBody> || std::is_same_v<T, std::string_view>;
+};
+
+template<typename T>
+inline constexpr bool is_raw_body_type_v = is_raw_body_type<T>::value;
+
+/**
+ * Helper function to get the payload bytes of a raw body type
+ */
+inline std::string_view RawBodyBytes(const RawBody& body) {
+    return body.GetBytes();
+}
+
+inline std::string_view RawBodyBytes(std::string_view body) {
+    return body;
+}
+
+/**
+ * Helper function to get the default Content-Type of a raw body type
+ * std::string_view carries no type information, so it is sent as octet-stream
+ * unless the ResponseEntity sets a Content-Type header.
+ */
+inline StdString RawBodyContentType(const RawBody& body) {
+    return body.GetContentType();
+}
+
+inline StdString RawBodyContentType(std::string_view /*body*/) {
+    return "application/octet-stream";
+}
+
+#endif // RAW_BODY_H
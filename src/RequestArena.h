@@ -0,0 +1,137 @@
+#ifndef REQUEST_ARENA_H
+#define REQUEST_ARENA_H
+
+#include <StandardDefines.h>
+
+/**
+ * Per-request arena for short-lived dispatch bookkeeping
+ *
+ * Define HTTP_ENABLE_REQUEST_ARENA to back path segments and path-variable
+ * bindings with a std::pmr::monotonic_buffer_resource over an inline buffer of
+ * HTTP_REQUEST_ARENA_SIZE bytes. Allocations are bump-pointer only and are
+ * released in bulk when the arena goes out of scope at the end of
+ * DispatchRequest; if the buffer is exhausted the arena falls back to the heap.
+ *
+ * Without the define, or on toolchains without <memory_resource>, the same
+ * code compiles against the regular heap containers.
+ *
+ * RequestScope places @Scope("REQUEST") beans in the same arena through
+ * Allocate(), so each request has a single allocator either way.
+ *
+ * Anything handed to the server library (response headers and body) is still
+ * heap-allocated, because SimpleHttpResponse takes plain StdString / Map.
+ */
+
+/**
+ * Inline bytes per request, shared by route matching and REQUEST beans
+ */
+#ifndef HTTP_REQUEST_ARENA_SIZE
+#define HTTP_REQUEST_ARENA_SIZE 768
+#endif
+
+#if defined(HTTP_ENABLE_REQUEST_ARENA) && defined(__has_include)
+    #if __has_include(<memory_resource>)
+        #define HTTP_REQUEST_ARENA_ACTIVE 1
+    #endif
+#endif
+
+#ifdef HTTP_REQUEST_ARENA_ACTIVE
+
+#include <memory_resource>
+#include <cstddef>
+
+template<typename T>
+using ArenaVector = std::pmr::vector<T>;
+
+class RequestArena {
+    Private alignas(std::max_align_t) std::byte buffer_[HTTP_REQUEST_ARENA_SIZE];
+    Private std::pmr::monotonic_buffer_resource resource_;
+
+public:
+    RequestArena()
+        : resource_(buffer_, sizeof(buffer_), std::pmr::new_delete_resource()) {
+    }
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    /**
+     * Create an empty container that allocates from this arena
+     */
+    template<typename Container>
+    Container Make() {
+        return Container(&resource_);
+    }
+
+    /**
+     * Raw storage, released with the arena
+     *
+     * @return Never nullptr; past the inline buffer the arena takes memory
+     *         from the heap and still releases it in bulk
+     */
+    Void* Allocate(Size bytes, Size alignment) {
+        return resource_.allocate(bytes, alignment);
+    }
+
+    /**
+     * Release everything allocated from the arena in one step
+     * Containers created from the arena must not be used afterwards.
+     */
+    Void Release() {
+        resource_.release();
+    }
+};
+
+#else
+
+#include <cstddef>
+
+template<typename T>
+using ArenaVector = Vector<T>;
+
+class RequestArena {
+    // Raw storage only (Allocate); containers stay on the heap
+    Private alignas(std::max_align_t) UChar buffer_[HTTP_REQUEST_ARENA_SIZE];
+    Private Size used_;
+
+public:
+    RequestArena() : used_(0) {
+    }
+
+    RequestArena(const RequestArena&) = delete;
+    RequestArena& operator=(const RequestArena&) = delete;
+
+    /**
+     * Create an empty heap-backed container
+     */
+    template<typename Container>
+    Container Make() {
+        return Container();
+    }
+
+    /**
+     * Raw storage from the inline buffer, released with the arena
+     *
+     * @return nullptr once the buffer is exhausted; the caller then allocates
+     *         from the heap and frees that memory itself
+     */
+    Void* Allocate(Size bytes, Size alignment) {
+        Size offset = (used_ + alignment - 1) & ~(alignment - 1);
+        if (offset + bytes > sizeof(buffer_)) {
+            return nullptr;
+        }
+        used_ = offset + bytes;
+        return buffer_ + offset;
+    }
+
+    /**
+     * Release the inline buffer
+     */
+    Void Release() {
+        used_ = 0;
+    }
+};
+
+#endif // HTTP_REQUEST_ARENA_ACTIVE
+
+#endif // REQUEST_ARENA_H
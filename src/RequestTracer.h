@@ -0,0 +1,307 @@
+#ifndef REQUEST_TRACER_H
+#define REQUEST_TRACER_H
+
+#include <StandardDefines.h>
+#include <string_view>
+#include "PipelineStage.h"
+#include "AllocationCounter.h"
+
+/**
+ * Per-stage request tracing
+ *
+ * Define HTTP_ENABLE_REQUEST_TRACING to record timestamps at the stage
+ * boundaries of sampled requests:
+ *   request-queue   HttpRequestManager enqueue -> HttpRequestProcessor dequeue
+ *   dispatch        HttpRequestDispatcher::DispatchRequest
+ *   routing         EndpointTrie search (inside dispatch)
+ *   handler         controller call and response conversion (inside dispatch)
+ *   serialization   ResponseEntityConverter body conversion (inside handler)
+ *   response-queue  HttpRequestProcessor enqueue -> HttpResponseProcessor dequeue
+ *   send            ToHttpString() and IServer::SendMessage
+ *
+ * A request is sampled when the hash of its request ID is a multiple of the
+ * sample interval (HTTP_TRACE_SAMPLE_EVERY, default 64, changeable at run time
+ * with RequestTracer::SetSampleEvery), so every stage reaches the same
+ * decision without shared state. Events go into a fixed lock-free ring of
+ * HTTP_TRACE_BUFFER_EVENTS entries (4096, 256 on Arduino); the oldest are
+ * overwritten.
+ *
+ * RequestTracer::ToChromeTraceJson() returns the buffered events as Chrome
+ * trace_event JSON (async begin/end events, one track per request) for
+ * chrome://tracing or Perfetto.
+ *
+ * Without the define every call compiles to nothing. RequestTraceSpan also
+ * attributes heap allocations to its stage when HTTP_ENABLE_ALLOCATION_COUNTING
+ * is defined (see AllocationCounter.h), independently of sampling.
+ *
+ * Example usage:
+ *   RequestTraceSpan routing(TraceStage::ROUTING);
+ *   ...
+ *   StdString json = RequestTracer::ToChromeTraceJson();
+ */
+
+#ifdef HTTP_ENABLE_REQUEST_TRACING
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+
+#ifdef ARDUINO
+    #include <Arduino.h>
+#else
+    #include <chrono>
+#endif
+
+#ifndef HTTP_TRACE_SAMPLE_EVERY
+#define HTTP_TRACE_SAMPLE_EVERY 64
+#endif
+
+#ifndef HTTP_TRACE_BUFFER_EVENTS
+    #ifdef ARDUINO
+        #define HTTP_TRACE_BUFFER_EVENTS 256
+    #else
+        #define HTTP_TRACE_BUFFER_EVENTS 4096
+    #endif
+#endif
+
+static_assert((HTTP_TRACE_BUFFER_EVENTS & (HTTP_TRACE_BUFFER_EVENTS - 1)) == 0,
+              "HTTP_TRACE_BUFFER_EVENTS must be a power of two");
+
+class RequestTracer {
+    /**
+     * One ring entry, guarded by a sequence number: odd while being written,
+     * 2 * (index + 1) once complete
+     */
+    Private struct Slot {
+        std::atomic<uint64_t> sequence{0};
+        std::atomic<uint64_t> traceId{0};
+        std::atomic<uint64_t> timestampNanos{0};
+        std::atomic<UInt8> stage{0};
+        std::atomic<Bool> begin{false};
+    };
+
+    Private struct State {
+        Slot slots[HTTP_TRACE_BUFFER_EVENTS];
+        std::atomic<uint64_t> head{0};
+        std::atomic<UInt> sampleEvery{HTTP_TRACE_SAMPLE_EVERY};
+    };
+
+    Private Static State& GetState() {
+        static State state;
+        return state;
+    }
+
+    Private Static uint64_t& CurrentTraceId() {
+        static thread_local uint64_t traceId = 0;
+        return traceId;
+    }
+
+    Private Static uint64_t NowNanos() {
+#ifdef ARDUINO
+        return static_cast<uint64_t>(micros()) * 1000u;
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * Trace ID of a request: FNV-1a hash of the request ID (0 = not traced)
+     */
+    Private Static uint64_t HashRequestId(std::string_view requestId) {
+        uint64_t hash = 14695981039346656037ull;
+        for (Char c : requestId) {
+            hash ^= static_cast<UChar>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash == 0 ? 1 : hash;
+    }
+
+    /**
+     * Sample one request in every n (1 traces everything, 0 disables tracing)
+     */
+    Public Static Void SetSampleEvery(UInt n) {
+        GetState().sampleEvery.store(n, std::memory_order_relaxed);
+    }
+
+    /**
+     * Trace ID if the request is sampled, otherwise 0
+     */
+    Public Static uint64_t TraceIdFor(std::string_view requestId) {
+        UInt sampleEvery = GetState().sampleEvery.load(std::memory_order_relaxed);
+        if (sampleEvery == 0 || requestId.empty()) {
+            return 0;
+        }
+        uint64_t hash = HashRequestId(requestId);
+        return hash % sampleEvery == 0 ? hash : 0;
+    }
+
+    /**
+     * Trace ID of the request being dispatched on this thread (0 if not sampled)
+     */
+    Public Static uint64_t Current() {
+        return CurrentTraceId();
+    }
+
+    Public Static Void SetCurrent(uint64_t traceId) {
+        CurrentTraceId() = traceId;
+    }
+
+    /**
+     * Record the begin or end of a stage; no-op for traceId 0
+     */
+    Public Static Void Record(uint64_t traceId, TraceStage stage, Bool begin) {
+        if (traceId == 0) {
+            return;
+        }
+        State& state = GetState();
+        uint64_t index = state.head.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = state.slots[index & (HTTP_TRACE_BUFFER_EVENTS - 1)];
+        slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.traceId.store(traceId, std::memory_order_relaxed);
+        slot.timestampNanos.store(NowNanos(), std::memory_order_relaxed);
+        slot.stage.store(static_cast<UInt8>(stage), std::memory_order_relaxed);
+        slot.begin.store(begin, std::memory_order_relaxed);
+        slot.sequence.store(2 * index + 2, std::memory_order_release);
+    }
+
+    Public Static Void Begin(std::string_view requestId, TraceStage stage) {
+        Record(TraceIdFor(requestId), stage, true);
+    }
+
+    Public Static Void End(std::string_view requestId, TraceStage stage) {
+        Record(TraceIdFor(requestId), stage, false);
+    }
+
+    /**
+     * Buffered events as Chrome trace_event JSON
+     * Slots being overwritten while the dump runs are skipped.
+     */
+    Public Static StdString ToChromeTraceJson() {
+        State& state = GetState();
+        StdString json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        Bool first = true;
+        char event[192];
+        for (Slot& slot : state.slots) {
+            uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence == 0 || (sequence & 1) != 0) {
+                continue;
+            }
+            uint64_t traceId = slot.traceId.load(std::memory_order_relaxed);
+            uint64_t timestamp = slot.timestampNanos.load(std::memory_order_relaxed);
+            TraceStage stage = static_cast<TraceStage>(slot.stage.load(std::memory_order_relaxed));
+            Bool begin = slot.begin.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence) {
+                continue;
+            }
+            std::snprintf(event, sizeof(event),
+                          "%s{\"name\":\"%s\",\"cat\":\"http\",\"ph\":\"%c\",\"id\":\"0x%llx\",\"ts\":%llu.%03u,\"pid\":1,\"tid\":1}",
+                          first ? "" : ",", TraceStageName(stage), begin ? 'b' : 'e',
+                          static_cast<unsigned long long>(traceId),
+                          static_cast<unsigned long long>(timestamp / 1000),
+                          static_cast<unsigned>(timestamp % 1000));
+            json += event;
+            first = false;
+        }
+        json += "]}";
+        return json;
+    }
+
+    /**
+     * Drop all buffered events
+     */
+    Public Static Void Clear() {
+        for (Slot& slot : GetState().slots) {
+            slot.sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * Records a stage for the duration of a scope
+ * Without a request ID the span belongs to the request currently being dispatched.
+ */
+class RequestTraceSpan {
+    Private AllocationStageScope allocationStage_;
+    Private uint64_t traceId_;
+    Private TraceStage stage_;
+
+    Public explicit RequestTraceSpan(TraceStage stage)
+        : allocationStage_(stage), traceId_(RequestTracer::Current()), stage_(stage) {
+        RequestTracer::Record(traceId_, stage_, true);
+    }
+
+    Public RequestTraceSpan(std::string_view requestId, TraceStage stage)
+        : allocationStage_(stage), traceId_(RequestTracer::TraceIdFor(requestId)), stage_(stage) {
+        RequestTracer::Record(traceId_, stage_, true);
+    }
+
+    Public ~RequestTraceSpan() {
+        RequestTracer::Record(traceId_, stage_, false);
+    }
+
+    RequestTraceSpan(const RequestTraceSpan&) = delete;
+    RequestTraceSpan& operator=(const RequestTraceSpan&) = delete;
+};
+
+/**
+ * Makes a sampled request the current one for nested spans while it is dispatched
+ */
+class RequestTraceScope {
+    Private uint64_t previous_;
+
+    Public explicit RequestTraceScope(std::string_view requestId)
+        : previous_(RequestTracer::Current()) {
+        RequestTracer::SetCurrent(RequestTracer::TraceIdFor(requestId));
+    }
+
+    Public ~RequestTraceScope() {
+        RequestTracer::SetCurrent(previous_);
+    }
+
+    RequestTraceScope(const RequestTraceScope&) = delete;
+    RequestTraceScope& operator=(const RequestTraceScope&) = delete;
+};
+
+#else
+
+class RequestTracer {
+    Public Static Void SetSampleEvery(UInt) {
+    }
+
+    Public Static Void Begin(std::string_view, TraceStage) {
+    }
+
+    Public Static Void End(std::string_view, TraceStage) {
+    }
+
+    Public Static StdString ToChromeTraceJson() {
+        return "{\"traceEvents\":[]}";
+    }
+
+    Public Static Void Clear() {
+    }
+};
+
+class RequestTraceSpan {
+    Private AllocationStageScope allocationStage_;
+
+    Public explicit RequestTraceSpan(TraceStage stage)
+        : allocationStage_(stage) {
+    }
+
+    Public RequestTraceSpan(std::string_view, TraceStage stage)
+        : allocationStage_(stage) {
+    }
+};
+
+class RequestTraceScope {
+    Public explicit RequestTraceScope(std::string_view) {
+    }
+};
+
+#endif // HTTP_ENABLE_REQUEST_TRACING
+
+#endif // REQUEST_TRACER_H
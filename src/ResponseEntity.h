@@ -4,6 +4,7 @@
 #include "StandardDefines.h"
 #include "HttpStatus.h"
 #include <NayanSerializer.h>
+#include <utility>
 
 /**
  * ResponseEntity class similar to Spring Boot's ResponseEntity
@@ -37,6 +38,13 @@ public:
         : status_(status), headers_(), body_(body) {
     }
 
+    /**
+     * Constructor with status and body, taking ownership of the body
+     */
+    ResponseEntity(HttpStatus status, T&& body) 
+        : status_(status), headers_(), body_(std::move(body)) {
+    }
+
     /**
      * Constructor with status, body, and headers
      */
@@ -44,6 +52,13 @@ public:
         : status_(status), headers_(headers), body_(body) {
     }
 
+    /**
+     * Constructor with status, body, and headers, taking ownership of the body
+     */
+    ResponseEntity(HttpStatus status, T&& body, const Map<StdString, StdString>& headers) 
+        : status_(status), headers_(headers), body_(std::move(body)) {
+    }
+
     /**
      * Copy constructor
      */
@@ -51,6 +66,15 @@ public:
         : status_(other.status_), headers_(other.headers_), body_(other.body_) {
     }
 
+    /**
+     * Move constructor
+     * Declared explicitly: the user-declared copy constructor would otherwise
+     * turn every move (e.g. returning a named entity) into a copy of the body.
+     */
+    ResponseEntity(ResponseEntity&& other) 
+        : status_(other.status_), headers_(std::move(other.headers_)), body_(std::move(other.body_)) {
+    }
+
     /**
      * Assignment operator
      */
@@ -63,6 +87,18 @@ public:
         return *this;
     }
 
+    /**
+     * Move assignment operator
+     */
+    ResponseEntity& operator=(ResponseEntity&& other) {
+        if (this != &other) {
+            status_ = other.status_;
+            headers_ = std::move(other.headers_);
+            body_ = std::move(other.body_);
+        }
+        return *this;
+    }
+
     /**
      * Get the HTTP status code
      */
@@ -220,6 +256,14 @@ public:
         return ResponseEntity<T>(HttpStatus::OK, body);
     }
 
+    /**
+     * Create ResponseEntity with OK (200) status, taking ownership of the body
+     * e.g. ResponseEntity<RawBody>::Ok(RawBody(std::move(png), "image/png")) moves the bytes
+     */
+    Static ResponseEntity<T> Ok(T&& body) {
+        return ResponseEntity<T>(HttpStatus::OK, std::move(body));
+    }
+
     /**
      * Create ResponseEntity with OK (200) status and headers
      */
@@ -227,6 +271,13 @@ public:
         return ResponseEntity<T>(HttpStatus::OK, body, headers);
     }
 
+    /**
+     * Create ResponseEntity with OK (200) status and headers, taking ownership of the body
+     */
+    Static ResponseEntity<T> Ok(T&& body, const Map<StdString, StdString>& headers) {
+        return ResponseEntity<T>(HttpStatus::OK, std::move(body), headers);
+    }
+
     /**
      * Create ResponseEntity with CREATED (201) status
      */
@@ -3,6 +3,10 @@
 
 #include "ResponseEntity.h"
 #include "HttpStatus.h"
+#include "ContentFormat.h"
+#include "RawBody.h"
+#include "ObjectPool.h"
+#include "RequestTracer.h"
 #include <IHttpResponse.h>
 #include <SimpleHttpResponse.h>
 #include <NayanSerializer.h>
@@ -11,7 +15,7 @@
  * Utility functions to convert ResponseEntity<T> to IHttpResponse
  * 
  * This utility provides template functions to convert ResponseEntity objects
- * to IHttpResponse objects, handling primitive types, strings, and complex types.
+ * to IHttpResponse objects, handling primitive types, strings, raw bodies, and complex types.
  */
 
 namespace ResponseEntityConverter {
@@ -45,6 +49,52 @@ namespace ResponseEntityConverter {
     template<typename T>
     inline constexpr bool is_primitive_type_v = is_primitive_type<T>::value;
 
+    /**
+     * Type trait to check if a DTO reports its serialized length itself.
+     * A DTO opts in with `Size SerializedSize() const`, which must return the
+     * exact length of the JSON its Serialize() produces.
+     */
+    template<typename T, typename = void>
+    struct has_serialized_size : std::false_type {};
+
+    template<typename T>
+    struct has_serialized_size<T, std::void_t<decltype(std::declval<const T&>().SerializedSize())>> : std::true_type {};
+
+    template<typename T>
+    inline constexpr bool has_serialized_size_v = has_serialized_size<T>::value;
+
+    /**
+     * Compute the length a response body would have on the wire without producing it
+     * Used for HEAD requests answered by a GET handler.
+     * Raw bodies are measured in place, and DTOs with SerializedSize() are asked
+     * for their length, so neither is serialized. Other types still go through
+     * SerializationUtility, which has no size-only mode: the body is serialized
+     * to JSON text and only its length is kept, so such a HEAD costs about as
+     * much CPU as the GET it mirrors.
+     *
+     * @tparam T The type of the response body
+     * @param body The body value to measure
+     * @param contentType Set to the Content-Type the body would be sent with, if not JSON
+     * @return The body length in bytes
+     */
+    template<typename T>
+    inline Size MeasureBody(const T& body, StdString& contentType) {
+        using namespace nayan::serializer;
+
+        if constexpr (is_raw_body_type_v<T>) {
+            contentType = RawBodyContentType(body);
+            return RawBodyBytes(body).size();
+        } else if constexpr (is_primitive_type_v<T>) {
+            return SerializationUtility::Serialize<T>(body).size();
+        } else if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+            return std::char_traits<char>::length(body);
+        } else if constexpr (has_serialized_size_v<T>) {
+            return static_cast<Size>(body.SerializedSize());
+        } else {
+            return SerializationUtility::Serialize<T>(body).size();
+        }
+    }
+
     /**
      * Convert ResponseEntity<T> to IHttpResponse (without request ID)
      * Handles primitive types, strings, and complex types
@@ -52,10 +102,13 @@ namespace ResponseEntityConverter {
      * 
      * @tparam T The type of the response body
      * @param entity The ResponseEntity<T> to convert
+     * @param format Per-request options; format.omitBody answers HEAD with the length only
      * @return IHttpResponsePtr (shared_ptr)
      */
     template<typename T>
-    inline IHttpResponsePtr ToHttpResponse(const ResponseEntity<T>& entity) {
+    inline IHttpResponsePtr ToHttpResponse(const ResponseEntity<T>& entity, const ContentFormat& format = ContentFormat()) {
+        RequestTraceSpan serializationSpan(TraceStage::SERIALIZATION);
+        
         // Get status code and message
         HttpStatus status = entity.GetStatus();
         UInt statusCode = StatusToInt(status);
@@ -70,12 +123,30 @@ namespace ResponseEntityConverter {
         // Special handling for Void - no body
         if constexpr (std::is_same_v<T, Void>) {
             bodyStr = "";
+        } else if (format.omitBody) {
+            // HEAD - report the length the body would have, send no body bytes
+            // A Content-Length already set by the handler is trusted as-is
+            if (headers.find("Content-Length") == headers.end()) {
+                StdString contentType;
+                headers["Content-Length"] = std::to_string(MeasureBody<T>(entity.GetBody(), contentType));
+                if (!contentType.empty() && headers.find("Content-Type") == headers.end()) {
+                    headers["Content-Type"] = contentType;
+                }
+            }
         } else {
             // Convert body to string based on type
             using namespace nayan::serializer;
             
-            // Check if T is primitive type (includes strings from StandardDefines)
-            if constexpr (is_primitive_type_v<T>) {
+            // Check if T is a raw body type (RawBody, std::string_view)
+            if constexpr (is_raw_body_type_v<T>) {
+                // Raw bytes - copied verbatim, no serialization or escaping
+                // An explicit Content-Type header on the entity takes precedence
+                std::string_view bytes = RawBodyBytes(entity.GetBody());
+                bodyStr.assign(bytes.data(), bytes.size());
+                if (headers.find("Content-Type") == headers.end()) {
+                    headers["Content-Type"] = RawBodyContentType(entity.GetBody());
+                }
+            } else if constexpr (is_primitive_type_v<T>) {
                 // Primitive type or string (StdString, CStdString) - convert directly to string
                 bodyStr = SerializationUtility::Serialize<T>(entity.GetBody());
             } else if constexpr (std::is_same_v<T, std::string> ||
@@ -92,7 +163,7 @@ namespace ResponseEntityConverter {
         
         // Create SimpleHttpResponse with status, headers, and body (empty requestId)
         StdString emptyRequestId = "";
-        IHttpResponsePtr response = make_ptr<SimpleHttpResponse>(emptyRequestId, statusCode, statusMessage, headers, bodyStr);
+        IHttpResponsePtr response = make_pooled_ptr<SimpleHttpResponse>(emptyRequestId, statusCode, statusMessage, std::move(headers), std::move(bodyStr));
         return response;
     }
 
@@ -103,10 +174,13 @@ namespace ResponseEntityConverter {
      * @tparam T The type of the response body
      * @param requestId The unique request ID (GUID) for this response
      * @param entity The ResponseEntity<T> to convert
+     * @param format Per-request options; format.omitBody answers HEAD with the length only
      * @return IHttpResponsePtr (shared_ptr)
      */
     template<typename T>
-    inline IHttpResponsePtr ToHttpResponse(CStdString& requestId, const ResponseEntity<T>& entity) {
+    inline IHttpResponsePtr ToHttpResponse(CStdString& requestId, const ResponseEntity<T>& entity, const ContentFormat& format = ContentFormat()) {
+        RequestTraceSpan serializationSpan(TraceStage::SERIALIZATION);
+        
         // Get status code and message
         HttpStatus status = entity.GetStatus();
         UInt statusCode = StatusToInt(status);
@@ -121,12 +195,30 @@ namespace ResponseEntityConverter {
         // Special handling for Void - no body
         if constexpr (std::is_same_v<T, Void>) {
             bodyStr = "";
+        } else if (format.omitBody) {
+            // HEAD - report the length the body would have, send no body bytes
+            // A Content-Length already set by the handler is trusted as-is
+            if (headers.find("Content-Length") == headers.end()) {
+                StdString contentType;
+                headers["Content-Length"] = std::to_string(MeasureBody<T>(entity.GetBody(), contentType));
+                if (!contentType.empty() && headers.find("Content-Type") == headers.end()) {
+                    headers["Content-Type"] = contentType;
+                }
+            }
         } else {
             // Convert body to string based on type
             using namespace nayan::serializer;
             
-            // Check if T is primitive type (includes strings from StandardDefines)
-            if constexpr (is_primitive_type_v<T>) {
+            // Check if T is a raw body type (RawBody, std::string_view)
+            if constexpr (is_raw_body_type_v<T>) {
+                // Raw bytes - copied verbatim, no serialization or escaping
+                // An explicit Content-Type header on the entity takes precedence
+                std::string_view bytes = RawBodyBytes(entity.GetBody());
+                bodyStr.assign(bytes.data(), bytes.size());
+                if (headers.find("Content-Type") == headers.end()) {
+                    headers["Content-Type"] = RawBodyContentType(entity.GetBody());
+                }
+            } else if constexpr (is_primitive_type_v<T>) {
                 // Primitive type or string (StdString, CStdString) - convert directly to string
                 bodyStr = SerializationUtility::Serialize<T>(entity.GetBody());
             } else if constexpr (std::is_same_v<T, std::string> ||
@@ -142,7 +234,7 @@ namespace ResponseEntityConverter {
         }
         
         // Create SimpleHttpResponse with status, headers, and body
-        IHttpResponsePtr response = make_ptr<SimpleHttpResponse>(requestId, statusCode, statusMessage, headers, bodyStr);
+        IHttpResponsePtr response = make_pooled_ptr<SimpleHttpResponse>(requestId, statusCode, statusMessage, std::move(headers), std::move(bodyStr));
         return response;
     }
 
@@ -163,7 +255,7 @@ namespace ResponseEntityConverter {
         
         // Create SimpleHttpResponse with status, headers, and empty body (empty requestId)
         StdString emptyRequestId = "";
-        IHttpResponsePtr response = make_ptr<SimpleHttpResponse>(emptyRequestId, statusCode, statusMessage, headers, bodyStr);
+        IHttpResponsePtr response = make_pooled_ptr<SimpleHttpResponse>(emptyRequestId, statusCode, statusMessage, std::move(headers), std::move(bodyStr));
         return response;
     }
 
@@ -183,7 +275,7 @@ namespace ResponseEntityConverter {
         StdString bodyStr = "";
         
         // Create SimpleHttpResponse with status, headers, and empty body
-        IHttpResponsePtr response = make_ptr<SimpleHttpResponse>(requestId, statusCode, statusMessage, headers, bodyStr);
+        IHttpResponsePtr response = make_pooled_ptr<SimpleHttpResponse>(requestId, statusCode, statusMessage, std::move(headers), std::move(bodyStr));
         return response;
     }
 
@@ -194,17 +286,34 @@ namespace ResponseEntityConverter {
      * 
      * @tparam T The type of the body (primitive or string)
      * @param body The body value to convert
+     * @param format Per-request options; format.omitBody answers HEAD with the length only
      * @return IHttpResponsePtr with 200 OK status
      */
     template<typename T>
-    inline IHttpResponsePtr CreateOkResponse(const T& body) {
+    inline IHttpResponsePtr CreateOkResponse(const T& body, const ContentFormat& format = ContentFormat()) {
+        RequestTraceSpan serializationSpan(TraceStage::SERIALIZATION);
+        
         using namespace nayan::serializer;
         
         // Convert body to string
         StdString bodyStr;
+        StdString contentType = "application/json";
+        
+        Map<StdString, StdString> headers;
         
-        // Check if T is primitive type (includes strings from StandardDefines)
-        if constexpr (is_primitive_type_v<T>) {
+        if (format.omitBody) {
+            // HEAD - report the length the body would have, send no body bytes
+            StdString measuredContentType;
+            headers["Content-Length"] = std::to_string(MeasureBody<T>(body, measuredContentType));
+            if (!measuredContentType.empty()) {
+                contentType = measuredContentType;
+            }
+        } else if constexpr (is_raw_body_type_v<T>) {
+            // Raw bytes - copied verbatim, no serialization or escaping
+            std::string_view bytes = RawBodyBytes(body);
+            bodyStr.assign(bytes.data(), bytes.size());
+            contentType = RawBodyContentType(body);
+        } else if constexpr (is_primitive_type_v<T>) {
             // Primitive type or string (StdString, CStdString) - convert directly to string
             bodyStr = SerializationUtility::Serialize<T>(body);
         } else if constexpr (std::is_same_v<T, std::string>) {
@@ -222,10 +331,9 @@ namespace ResponseEntityConverter {
         StdString emptyRequestId = "";
         UInt statusCode = 200;
         StdString statusMessage = "OK";
-        Map<StdString, StdString> headers;
-        headers["Content-Type"] = "application/json";
+        headers["Content-Type"] = contentType;
         
-        IHttpResponsePtr response = make_ptr<SimpleHttpResponse>(emptyRequestId, statusCode, statusMessage, headers, bodyStr);
+        IHttpResponsePtr response = make_pooled_ptr<SimpleHttpResponse>(emptyRequestId, statusCode, statusMessage, std::move(headers), std::move(bodyStr));
         return response;
     }
 
@@ -236,17 +344,34 @@ namespace ResponseEntityConverter {
      * @tparam T The type of the body (primitive or string)
      * @param requestId The unique request ID (GUID) for this response
      * @param body The body value to convert
+     * @param format Per-request options; format.omitBody answers HEAD with the length only
      * @return IHttpResponsePtr with 200 OK status
      */
     template<typename T>
-    inline IHttpResponsePtr CreateOkResponse(CStdString& requestId, const T& body) {
+    inline IHttpResponsePtr CreateOkResponse(CStdString& requestId, const T& body, const ContentFormat& format = ContentFormat()) {
+        RequestTraceSpan serializationSpan(TraceStage::SERIALIZATION);
+        
         using namespace nayan::serializer;
         
         // Convert body to string
         StdString bodyStr;
+        StdString contentType = "application/json";
         
-        // Check if T is primitive type (includes strings from StandardDefines)
-        if constexpr (is_primitive_type_v<T>) {
+        Map<StdString, StdString> headers;
+        
+        if (format.omitBody) {
+            // HEAD - report the length the body would have, send no body bytes
+            StdString measuredContentType;
+            headers["Content-Length"] = std::to_string(MeasureBody<T>(body, measuredContentType));
+            if (!measuredContentType.empty()) {
+                contentType = measuredContentType;
+            }
+        } else if constexpr (is_raw_body_type_v<T>) {
+            // Raw bytes - copied verbatim, no serialization or escaping
+            std::string_view bytes = RawBodyBytes(body);
+            bodyStr.assign(bytes.data(), bytes.size());
+            contentType = RawBodyContentType(body);
+        } else if constexpr (is_primitive_type_v<T>) {
             // Primitive type or string (StdString, CStdString) - convert directly to string
             bodyStr = SerializationUtility::Serialize<T>(body);
         } else if constexpr (std::is_same_v<T, std::string>) {
@@ -263,10 +388,9 @@ namespace ResponseEntityConverter {
         // Create SimpleHttpResponse with 200 OK status
         UInt statusCode = 200;
         StdString statusMessage = "OK";
-        Map<StdString, StdString> headers;
-        headers["Content-Type"] = "application/json";
+        headers["Content-Type"] = contentType;
         
-        IHttpResponsePtr response = make_ptr<SimpleHttpResponse>(requestId, statusCode, statusMessage, headers, bodyStr);
+        IHttpResponsePtr response = make_pooled_ptr<SimpleHttpResponse>(requestId, statusCode, statusMessage, std::move(headers), std::move(bodyStr));
         return response;
     }
 
@@ -285,7 +409,7 @@ namespace ResponseEntityConverter {
         Map<StdString, StdString> headers;
         StdString emptyBody = "";
         
-        IHttpResponsePtr response = make_ptr<SimpleHttpResponse>(emptyRequestId, statusCode, statusMessage, headers, emptyBody);
+        IHttpResponsePtr response = make_pooled_ptr<SimpleHttpResponse>(emptyRequestId, statusCode, statusMessage, headers, emptyBody);
         return response;
     }
 
@@ -303,7 +427,7 @@ namespace ResponseEntityConverter {
         Map<StdString, StdString> headers;
         StdString emptyBody = "";
         
-        IHttpResponsePtr response = make_ptr<SimpleHttpResponse>(requestId, statusCode, statusMessage, headers, emptyBody);
+        IHttpResponsePtr response = make_pooled_ptr<SimpleHttpResponse>(requestId, statusCode, statusMessage, headers, emptyBody);
         return response;
     }
 
@@ -0,0 +1,220 @@
+#ifndef ROUTER_H
+#define ROUTER_H
+
+#include <StandardDefines.h>
+#include <tuple>
+#include <utility>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include "HttpRequestDispatcher.h"
+
+/**
+ * Router - route registration in C++, without the pre-build code generator
+ *
+ * Binds a controller method to a route at compile time:
+ *   Router router;
+ *   router.Get<&IUserController::GetUser>("/api/user/{id}");
+ *   router.Post<&IUserController::CreateUser>("/api/user");
+ *
+ * Parameter and return types are deduced from the member function pointer.
+ * Parameters of string or arithmetic type bind, in order, to the path variables
+ * of the pattern (ConvertToType); one parameter of any other type is the request
+ * body (DeserializeBody). The return value is converted like in generated
+ * handlers: ResponseEntity<T> with ToHttpResponse, Void with an empty 200,
+ * anything else with CreateOkResponse.
+ *
+ * Every route becomes a plain HttpRequestHandler (RouteHandler<Method>::Handle)
+ * with all conversions resolved at compile time. SINGLETON controllers
+ * (is_singleton_bean_v) are read from SingletonBeanSlot, like in generated
+ * handlers; other scopes are resolved per request through
+ * Implementation<Interface>::type::GetInstance(). Either way the controller is
+ * called through HttpRequestDispatcher::Devirtualize().
+ *
+ * Router replaces the web code generator only. Implementation<> and
+ * GetInstance() still come from the DI pre-build step, or from handwritten
+ * equivalents where that step cannot run (see tests/AllocationBudgetTest.cpp).
+ *
+ * Routes must be registered before the server starts (the dispatcher copies
+ * them when it is constructed). They can be combined with generated mappings.
+ */
+
+/**
+ * Parameter and return types of a controller method
+ */
+template<typename Method>
+struct RouteMethodTraits;
+
+template<typename Interface, typename Return, typename... Args>
+struct RouteMethodTraits<Return (Interface::*)(Args...)> {
+    using interface_type = Interface;
+    using return_type = Return;
+    using argument_types = std::tuple<Args...>;
+};
+
+template<typename Interface, typename Return, typename... Args>
+struct RouteMethodTraits<Return (Interface::*)(Args...) const> : RouteMethodTraits<Return (Interface::*)(Args...)> {};
+
+/**
+ * Parameters of these types are path variables, all others the request body
+ * std::string_view counts as a path variable so it is never taken for the body,
+ * but is rejected when bound: decoded path variables have no storage to view.
+ */
+template<typename Type>
+inline constexpr Bool is_path_variable_type_v = std::is_arithmetic_v<Type> || std::is_same_v<Type, StdString> ||
+                                                std::is_same_v<Type, std::string_view>;
+
+template<typename Type>
+struct is_response_entity : std::false_type {};
+
+template<typename Type>
+struct is_response_entity<ResponseEntity<Type>> : std::true_type {
+    using body_type = Type;
+};
+
+/**
+ * Handler for one controller method
+ *
+ * @tparam Method Pointer to the controller interface method
+ */
+template<auto Method>
+class RouteHandler {
+    using Traits = RouteMethodTraits<decltype(Method)>;
+    using Interface = typename Traits::interface_type;
+    using Return = typename Traits::return_type;
+    using Arguments = typename Traits::argument_types;
+
+    template<Size Index>
+    using Argument = std::tuple_element_t<Index, Arguments>;
+
+    template<Size Index>
+    using Value = std::remove_cv_t<std::remove_reference_t<Argument<Index>>>;
+
+    /**
+     * Position among the path variables of the parameter at Index
+     */
+    Private template<Size... Indexes>
+    Static constexpr Size PathVariablePosition(Size index, std::index_sequence<Indexes...>) {
+        constexpr Bool isPathVariable[] = {is_path_variable_type_v<Value<Indexes>>..., false};
+        Size position = 0;
+        for (Size i = 0; i < index; ++i) {
+            if (isPathVariable[i]) {
+                ++position;
+            }
+        }
+        return position;
+    }
+
+    Private template<Size Index>
+    Static Value<Index> Bind(const HttpRequestView& request) {
+        static_assert(!std::is_lvalue_reference_v<Argument<Index>> || std::is_const_v<std::remove_reference_t<Argument<Index>>>,
+                      "Route parameters must be taken by value or by const reference");
+        static_assert(!std::is_same_v<Value<Index>, std::string_view>,
+                      "Route path variables are URL-decoded; take them as StdString, not std::string_view");
+        if constexpr (is_path_variable_type_v<Value<Index>>) {
+            constexpr Size position = PathVariablePosition(Index, std::make_index_sequence<std::tuple_size_v<Arguments>>());
+            return HttpRequestDispatcher::ConvertToType<Value<Index>>(request.GetPathVariable(position));
+        } else {
+            return HttpRequestDispatcher::DeserializeBody<Value<Index>>(request.GetBody());
+        }
+    }
+
+    Private template<typename Bean, Size... Indexes>
+    Static IHttpResponsePtr Invoke(Bean& controller, const HttpRequestView& request, const ContentFormat& format, std::index_sequence<Indexes...>) {
+        if constexpr (std::is_void_v<Return>) {
+            (controller.*Method)(Bind<Indexes>(request)...);
+            return ResponseEntityConverter::CreateOkResponse();
+        } else if constexpr (is_response_entity<std::decay_t<Return>>::value) {
+            std::decay_t<Return> returnValue = (controller.*Method)(Bind<Indexes>(request)...);
+            return ResponseEntityConverter::ToHttpResponse<typename is_response_entity<std::decay_t<Return>>::body_type>(returnValue, format);
+        } else {
+            std::decay_t<Return> returnValue = (controller.*Method)(Bind<Indexes>(request)...);
+            return ResponseEntityConverter::CreateOkResponse<std::decay_t<Return>>(returnValue, format);
+        }
+    }
+
+    Private template<Size... Indexes>
+    Static constexpr Size CountBodyParameters(std::index_sequence<Indexes...>) {
+        return (Size(0) + ... + (is_path_variable_type_v<Value<Indexes>> ? 0 : 1));
+    }
+
+    Public Static constexpr Size parameterCount = std::tuple_size_v<Arguments>;
+    Public Static constexpr Size bodyParameterCount = CountBodyParameters(std::make_index_sequence<parameterCount>());
+    Public Static constexpr Size pathVariableCount = parameterCount - bodyParameterCount;
+
+    static_assert(bodyParameterCount <= 1, "A route can bind at most one request body parameter");
+
+    /**
+     * The HttpRequestHandler registered for the route
+     */
+    Public Static IHttpResponsePtr Handle(const HttpRequestView& request, const ContentFormat& format) {
+        if constexpr (is_singleton_bean_v<Interface>) {
+            return Invoke(SingletonBeanSlot<Interface>::Get(), request, format, std::make_index_sequence<parameterCount>());
+        } else {
+            auto bean = Implementation<Interface>::type::GetInstance();
+            auto& controller = HttpRequestDispatcher::Devirtualize(*bean);
+            return Invoke(controller, request, format, std::make_index_sequence<parameterCount>());
+        }
+    }
+};
+
+class Router {
+    /**
+     * Number of {variable} segments in a route pattern
+     */
+    Private Static Size CountPathVariables(CStdString& pattern) {
+        Size count = 0;
+        for (Char c : pattern) {
+            if (c == '{') {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * Register a controller method for any HTTP method
+     *
+     * @tparam Method Pointer to the controller interface method
+     * @param method HTTP method of the route
+     * @param pattern Route pattern, e.g. "/api/user/{id}"
+     * @throws std::invalid_argument if the pattern has a different number of path
+     *         variables than the method has path variable parameters
+     */
+    Public template<auto Method>
+    Void Route(HttpMethod method, CStdString& pattern) {
+        if (CountPathVariables(pattern) != RouteHandler<Method>::pathVariableCount) {
+            throw std::invalid_argument("Route " + pattern + " has " + std::to_string(CountPathVariables(pattern)) +
+                                        " path variable(s) but the handler binds " +
+                                        std::to_string(RouteHandler<Method>::pathVariableCount));
+        }
+        HttpRequestDispatcher::RegisterRoute(method, pattern, &RouteHandler<Method>::Handle);
+    }
+
+    Public template<auto Method>
+    Void Get(CStdString& pattern) {
+        Route<Method>(HttpMethod::GET, pattern);
+    }
+
+    Public template<auto Method>
+    Void Post(CStdString& pattern) {
+        Route<Method>(HttpMethod::POST, pattern);
+    }
+
+    Public template<auto Method>
+    Void Put(CStdString& pattern) {
+        Route<Method>(HttpMethod::PUT, pattern);
+    }
+
+    Public template<auto Method>
+    Void Patch(CStdString& pattern) {
+        Route<Method>(HttpMethod::PATCH, pattern);
+    }
+
+    Public template<auto Method>
+    Void Delete(CStdString& pattern) {
+        Route<Method>(HttpMethod::DELETE, pattern);
+    }
+};
+
+#endif // ROUTER_H
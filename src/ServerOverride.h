@@ -0,0 +1,53 @@
+#ifndef SERVER_OVERRIDE_H
+#define SERVER_OVERRIDE_H
+
+#include <StandardDefines.h>
+#include <IServer.h>
+#include <ServerProvider.h>
+
+/**
+ * ServerOverride - replaces the server returned by ServerProvider
+ *
+ * HttpRequestManager and HttpResponseProcessor take their IServer from
+ * GetServer(): the installed override if there is one, otherwise
+ * ServerProvider::GetDefaultServer(). Installing a LoopbackServer runs the
+ * whole request pipeline in-process, without sockets (see LoadHarness.h).
+ *
+ * The override must be installed before the request manager and response
+ * processor beans are created, i.e. before anything resolves them.
+ *
+ * Example usage:
+ *   ServerOverride::Set(std::make_shared<LoopbackServer>());
+ */
+class ServerOverride {
+    Private Static IServerPtr& Slot() {
+        static IServerPtr server;
+        return server;
+    }
+
+    /**
+     * Install a server to be used instead of the default one
+     */
+    Public Static Void Set(IServerPtr server) {
+        Slot() = server;
+    }
+
+    /**
+     * Remove the installed server (beans created in the meantime keep it)
+     */
+    Public Static Void Clear() {
+        Slot() = nullptr;
+    }
+
+    /**
+     * The installed server, or ServerProvider::GetDefaultServer() if there is none
+     */
+    Public Static IServerPtr GetServer() {
+        if (Slot() != nullptr) {
+            return Slot();
+        }
+        return ServerProvider::GetDefaultServer();
+    }
+};
+
+#endif // SERVER_OVERRIDE_H
@@ -0,0 +1,136 @@
+/**
+ * Per-request heap allocation budgets of the request pipeline
+ *
+ * Sends requests for each route shape through the real HttpRequestManager
+ * (request queue, processor, dispatcher, response queue, response processor)
+ * against a LoopbackServer installed with ServerOverride, measures them with
+ * LoadHarness::MeasureAllocations() and fails when the average allocations per
+ * request exceed the route's budget. The budgets are the measured counts, plus
+ * SERIALIZER_ALLOWANCE on routes whose DTO goes through serializationlib (its
+ * allocations are outside this library). Each queue stage counts one
+ * allocation: the std::queue blocks allocated every few requests, rounded up
+ * by the per-request average. Lower the budgets when a change removes
+ * allocations, and treat a failure as a regression unless the extra
+ * allocation is intended.
+ *
+ * Built and registered with CTest by SPRINGBOOTPLUSPLUS_WEB_BUILD_TESTS.
+ */
+
+#define HTTP_ENABLE_ALLOCATION_COUNTING
+#define HTTP_DEFINE_ALLOCATION_HOOKS
+#include "AllocationCounter.h"
+
+#include <StandardDefines.h>
+#include <iostream>
+#include "HttpRequestManager.h"
+#include "Router.h"
+#include "LoopbackServer.h"
+#include "ServerOverride.h"
+#include "LoadHarness.h"
+
+// ============================================================================
+// Test controller, registered through Router (no code generation)
+// ============================================================================
+
+struct BudgetItem {
+    Int id = 0;
+    StdString name;
+
+    StdString Serialize() const {
+        return "{\"id\":" + std::to_string(id) + ",\"name\":\"" + name + "\"}";
+    }
+
+    Static BudgetItem Deserialize(CStdString& json) {
+        BudgetItem item;
+        Size name = json.find("\"name\":\"");
+        if (name != StdString::npos) {
+            name += 8;
+            item.name = json.substr(name, json.find('"', name) - name);
+        }
+        return item;
+    }
+};
+
+DefineStandardPointers(IBudgetController)
+class IBudgetController {
+    Public Virtual ~IBudgetController() = default;
+    Public Virtual StdString Hello() = 0;
+    Public Virtual ResponseEntity<BudgetItem> GetItem(Int id) = 0;
+    Public Virtual BudgetItem CreateItem(BudgetItem item) = 0;
+};
+
+class BudgetController final : public IBudgetController {
+    Public StdString Hello() override {
+        return "hello";
+    }
+
+    Public ResponseEntity<BudgetItem> GetItem(Int id) override {
+        BudgetItem item;
+        item.id = id;
+        item.name = "item";
+        return ResponseEntity<BudgetItem>::Ok(std::move(item));
+    }
+
+    Public BudgetItem CreateItem(BudgetItem item) override {
+        item.id = 1;
+        return item;
+    }
+
+    Public Static IBudgetControllerPtr GetInstance() {
+        static IBudgetControllerPtr instance(new BudgetController());
+        return instance;
+    }
+};
+
+template<>
+struct Implementation<IBudgetController> {
+    using type = BudgetController;
+    static constexpr bool singleton = true;
+};
+
+// ============================================================================
+// Budgets
+// ============================================================================
+
+struct AllocationBudget {
+    LoadRoute route;
+    uint64_t maxAllocations;
+};
+
+// Room for the serializer's own allocations when a DTO is read or written
+Static constexpr uint64_t SERIALIZER_ALLOWANCE = 8;
+
+int main() {
+    Router router;
+    router.Get<&IBudgetController::Hello>("/budget/hello");
+    router.Get<&IBudgetController::GetItem>("/budget/item/{id}");
+    router.Post<&IBudgetController::CreateItem>("/budget/item");
+
+    // The override must be installed before the manager and response processor beans are created
+    LoopbackServerPtr server = std::make_shared<LoopbackServer>();
+    ServerOverride::Set(server);
+    LoadHarness harness(server, Implementation<IHttpRequestManager>::type::GetInstance());
+
+    const Vector<AllocationBudget> budgets = {
+        {LoadRoute{"literal GET", HttpMethod::GET, "/budget/hello", "", {}}, 15},
+        {LoadRoute{"variable GET", HttpMethod::GET, "/budget/item/42", "", {}}, 12 + SERIALIZER_ALLOWANCE},
+        {LoadRoute{"POST with DTO", HttpMethod::POST, "/budget/item", "{\"name\":\"new\"}",
+                   {{"Content-Type", "application/json"}}}, 17 + SERIALIZER_ALLOWANCE},
+        {LoadRoute{"404", HttpMethod::GET, "/budget/missing", "", {}}, 11},
+    };
+
+    int failures = 0;
+    for (Size i = 0; i < budgets.size(); ++i) {
+        harness.AddRoute(budgets[i].route);
+        AllocationSnapshot perRequest = harness.MeasureAllocations(i);
+        uint64_t allocations = perRequest.Total().allocations;
+        Bool withinBudget = allocations <= budgets[i].maxAllocations;
+        std::cout << (withinBudget ? "ok   " : "FAIL ") << budgets[i].route.name << ": " << allocations
+                  << " allocations per request (budget " << budgets[i].maxAllocations << ") "
+                  << perRequest.ToJson() << std::endl;
+        if (!withinBudget) {
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+/**
+ * Automatic HEAD responses of GET routes
+ *
+ * Sends a GET and a HEAD for each route shape through HttpRequestDispatcher
+ * and checks the HEAD response text, as written by the response's
+ * ToHttpString(): its Content-Length must equal the length of the GET body
+ * and its body must be empty. DTOs with SerializedSize() must be measured
+ * without being serialized.
+ *
+ * Built and registered with CTest by SPRINGBOOTPLUSPLUS_WEB_BUILD_TESTS.
+ */
+
+#include <StandardDefines.h>
+#include <cctype>
+#include <iostream>
+#include "HttpRequestDispatcher.h"
+#include "Router.h"
+#include "LoopbackServer.h"
+
+// ============================================================================
+// Test controller, registered through Router (no code generation)
+// ============================================================================
+
+// Serialize() calls, to check that SerializedSize() is used instead on HEAD
+Static Size serializeCalls = 0;
+
+struct HeadItem {
+    Int id = 0;
+    StdString name;
+
+    StdString Serialize() const {
+        ++serializeCalls;
+        return "{\"id\":" + std::to_string(id) + ",\"name\":\"" + name + "\"}";
+    }
+
+    Static HeadItem Deserialize(CStdString& /*json*/) {
+        return HeadItem();
+    }
+};
+
+struct HeadSizedItem {
+    Int id = 0;
+    StdString name;
+
+    StdString Serialize() const {
+        ++serializeCalls;
+        return "{\"id\":" + std::to_string(id) + ",\"name\":\"" + name + "\"}";
+    }
+
+    Size SerializedSize() const {
+        return 17 + std::to_string(id).size() + name.size();
+    }
+
+    Static HeadSizedItem Deserialize(CStdString& /*json*/) {
+        return HeadSizedItem();
+    }
+};
+
+DefineStandardPointers(IHeadController)
+class IHeadController {
+    Public Virtual ~IHeadController() = default;
+    Public Virtual StdString Hello() = 0;
+    Public Virtual ResponseEntity<HeadItem> GetItem(Int id) = 0;
+    Public Virtual HeadSizedItem GetSizedItem(Int id) = 0;
+    Public Virtual RawBody GetRaw() = 0;
+};
+
+class HeadController final : public IHeadController {
+    Public StdString Hello() override {
+        return "hello";
+    }
+
+    Public ResponseEntity<HeadItem> GetItem(Int id) override {
+        HeadItem item;
+        item.id = id;
+        item.name = "item";
+        return ResponseEntity<HeadItem>::Ok(std::move(item));
+    }
+
+    Public HeadSizedItem GetSizedItem(Int id) override {
+        HeadSizedItem item;
+        item.id = id;
+        item.name = "sized";
+        return item;
+    }
+
+    Public RawBody GetRaw() override {
+        return RawBody("raw bytes", "text/plain");
+    }
+
+    Public Static IHeadControllerPtr GetInstance() {
+        static IHeadControllerPtr instance(new HeadController());
+        return instance;
+    }
+};
+
+template<>
+struct Implementation<IHeadController> {
+    using type = HeadController;
+    static constexpr bool singleton = true;
+};
+
+// ============================================================================
+// Response text helpers
+// ============================================================================
+
+/**
+ * Response text split into its header block and body
+ */
+struct ResponseText {
+    StdString headers;
+    StdString body;
+};
+
+ResponseText SplitResponse(CStdString& response) {
+    Size separator = response.find("\r\n\r\n");
+    Size separatorLength = 4;
+    if (separator == StdString::npos) {
+        separator = response.find("\n\n");
+        separatorLength = 2;
+    }
+    if (separator == StdString::npos) {
+        return ResponseText{response, ""};
+    }
+    return ResponseText{response.substr(0, separator), response.substr(separator + separatorLength)};
+}
+
+/**
+ * Content-Length header value, or -1 if the response has none
+ */
+long long ContentLength(CStdString& headers) {
+    StdString lower = headers;
+    for (Char& c : lower) {
+        c = static_cast<Char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    Size position = lower.find("content-length:");
+    if (position == StdString::npos) {
+        return -1;
+    }
+    position += 15;
+    while (position < headers.size() && headers[position] == ' ') {
+        ++position;
+    }
+    Size end = position;
+    while (end < headers.size() && std::isdigit(static_cast<unsigned char>(headers[end]))) {
+        ++end;
+    }
+    return end > position ? std::stoll(headers.substr(position, end - position)) : -1;
+}
+
+StdString Dispatch(HttpRequestDispatcher& dispatcher, HttpMethod method, CStdString& path) {
+    IHttpRequestPtr request = std::make_shared<LoopbackRequest>("head-test", method, path, "", Map<StdString, StdString>());
+    IHttpResponsePtr response = dispatcher.DispatchRequest(request);
+    return response != nullptr ? response->ToHttpString() : StdString();
+}
+
+// ============================================================================
+// Checks
+// ============================================================================
+
+struct HeadCase {
+    StdString name;
+    StdString path;
+    Bool expectSizeOnly;  // HEAD must not call Serialize()
+};
+
+int main() {
+    Router router;
+    router.Get<&IHeadController::Hello>("/head/hello");
+    router.Get<&IHeadController::GetItem>("/head/item/{id}");
+    router.Get<&IHeadController::GetSizedItem>("/head/sized/{id}");
+    router.Get<&IHeadController::GetRaw>("/head/raw");
+
+    HttpRequestDispatcher dispatcher;
+
+    const Vector<HeadCase> cases = {
+        {"string", "/head/hello", false},
+        {"ResponseEntity DTO", "/head/item/42", false},
+        {"DTO with SerializedSize", "/head/sized/7", true},
+        {"raw body", "/head/raw", true},
+    };
+
+    int failures = 0;
+    for (const HeadCase& headCase : cases) {
+        ResponseText get = SplitResponse(Dispatch(dispatcher, HttpMethod::GET, headCase.path));
+        Size serializeCallsBefore = serializeCalls;
+        ResponseText head = SplitResponse(Dispatch(dispatcher, HttpMethod::HEAD, headCase.path));
+        long long headLength = ContentLength(head.headers);
+
+        StdString error;
+        if (get.body.empty()) {
+            error = "GET returned no body";
+        } else if (headLength != static_cast<long long>(get.body.size())) {
+            error = "HEAD Content-Length " + std::to_string(headLength) + ", GET body " + std::to_string(get.body.size()) + " bytes";
+        } else if (!head.body.empty()) {
+            error = "HEAD returned " + std::to_string(head.body.size()) + " body bytes";
+        } else if (headCase.expectSizeOnly && serializeCalls != serializeCallsBefore) {
+            error = "HEAD serialized the body";
+        }
+
+        std::cout << (error.empty() ? "ok   " : "FAIL ") << headCase.name << ": Content-Length " << headLength;
+        if (!error.empty()) {
+            std::cout << " (" << error << ")";
+            ++failures;
+        }
+        std::cout << std::endl;
+    }
+    return failures == 0 ? 0 : 1;
+}
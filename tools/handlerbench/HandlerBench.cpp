@@ -0,0 +1,178 @@
+/**
+ * springbootplusplus-web-handlerbench - bean resolution cost of generated handlers
+ *
+ * Times how a generated handler obtains and calls its controller, through the
+ * HttpRequestHandler function pointer the dispatcher invokes. Two shapes are
+ * compared:
+ *   get-instance    Implementation<I>::type::GetInstance() on every request:
+ *                   the function-local static's guard check and a shared_ptr
+ *                   copy (atomic increment and decrement), then a virtual call
+ *   singleton-slot  SingletonBeanSlot<I>::Get(), resolved at startup: one
+ *                   load and null check, then a direct call on the final type
+ * Handlers return nullptr, so response construction is not part of the
+ * measurement. With --threads N every thread runs the loop against the same
+ * singleton, which is where the shared_ptr reference count contends.
+ *
+ * Example:
+ *   springbootplusplus-web-handlerbench --iterations 100000000 --threads 4
+ *   -> ns per call of each shape, averaged over the threads
+ *
+ * Built only with -DSPRINGBOOTPLUSPLUS_WEB_BUILD_HANDLERBENCH=ON. Compare
+ * numbers from the same machine and build type only.
+ */
+
+#include <StandardDefines.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "HttpRequestDispatcher.h"
+
+DefineStandardPointers(IBenchController)
+class IBenchController {
+    Public Virtual ~IBenchController() = default;
+    Public Virtual Size Handle(Size length) const = 0;
+};
+
+class BenchController final : public IBenchController {
+    Public Size Handle(Size length) const override {
+        return length + 1;
+    }
+
+    Public Static IBenchControllerPtr GetInstance() {
+        static IBenchControllerPtr instance(new BenchController());
+        return instance;
+    }
+};
+
+template<>
+struct Implementation<IBenchController> {
+    using type = BenchController;
+};
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Per-thread result of the controller calls, so the calls cannot be dropped
+thread_local Size handlerSink = 0;
+
+struct HandlerBenchOptions {
+    uint64_t iterations = 50000000;
+    UInt threads = 1;
+};
+
+/**
+ * Handler shape before SINGLETON controllers were resolved at startup
+ */
+IHttpResponsePtr GetInstanceHandler(const HttpRequestView& request, const ContentFormat& /*format*/) {
+    IBenchControllerPtr controller = Implementation<IBenchController>::type::GetInstance();
+    handlerSink += controller->Handle(request.GetPath().size());
+    return nullptr;
+}
+
+/**
+ * Handler shape generated for SINGLETON controllers (see L4_generate_function_pointer.py)
+ */
+IHttpResponsePtr SingletonSlotHandler(const HttpRequestView& request, const ContentFormat& /*format*/) {
+    auto& controller = SingletonBeanSlot<IBenchController>::Get();
+    handlerSink += controller.Handle(request.GetPath().size());
+    return nullptr;
+}
+
+Void PrintUsage() {
+    std::cout
+        << "Usage: springbootplusplus-web-handlerbench [options]\n"
+        << "  --iterations N        handler calls per thread and shape (default 50000000)\n"
+        << "  --threads N           threads calling the handlers concurrently (default 1)\n";
+}
+
+Bool ParseOptions(Int argc, char** argv, HandlerBenchOptions& options) {
+    for (Int i = 1; i < argc; ++i) {
+        StdString arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return false;
+        }
+        StdString value = argv[++i];
+        if (arg == "--iterations") {
+            options.iterations = std::stoull(value);
+        } else if (arg == "--threads") {
+            options.threads = static_cast<UInt>(std::stoul(value));
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            PrintUsage();
+            return false;
+        }
+    }
+    if (options.iterations == 0 || options.threads == 0) {
+        std::cerr << "--iterations and --threads must be at least 1" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Average nanoseconds per handler call over all threads
+ * The handler is read through a volatile pointer, as the dispatcher reads it
+ * from its mapping table, so the call is not inlined into the loop.
+ */
+double MeasureHandler(HttpRequestHandler handler, const HandlerBenchOptions& options) {
+    Map<StdString, StdString> headers;
+    Vector<double> nanosPerCall(options.threads);
+    Vector<std::thread> threads;
+    for (UInt t = 0; t < options.threads; ++t) {
+        threads.emplace_back([&, t] {
+            HttpRequestView view("1", "/bench", "", headers);
+            ContentFormat format;
+            HttpRequestHandler volatile target = handler;
+            Clock::time_point start = Clock::now();
+            for (uint64_t i = 0; i < options.iterations; ++i) {
+                target(view, format);
+            }
+            std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+            nanosPerCall[t] = elapsed.count() / static_cast<double>(options.iterations);
+            if (handlerSink == 0) {
+                std::cerr << "unexpected handler result" << std::endl;
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    double total = 0.0;
+    for (double value : nanosPerCall) {
+        total += value;
+    }
+    return total / options.threads;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    HandlerBenchOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    // What the BeanStartup entry of a SINGLETON bean does
+    SingletonBeanSlot<IBenchController>::Resolve();
+
+    // Warm up both paths (static initialization, caches) before measuring
+    HandlerBenchOptions warmup = options;
+    warmup.iterations = std::max<uint64_t>(options.iterations / 10, 1);
+    MeasureHandler(&GetInstanceHandler, warmup);
+    MeasureHandler(&SingletonSlotHandler, warmup);
+
+    double getInstance = MeasureHandler(&GetInstanceHandler, options);
+    double singletonSlot = MeasureHandler(&SingletonSlotHandler, options);
+
+    std::cout << "threads: " << options.threads << ", iterations per thread: " << options.iterations << "\n"
+              << "get-instance:   " << getInstance << " ns/call\n"
+              << "singleton-slot: " << singletonSlot << " ns/call" << std::endl;
+    return 0;
+}
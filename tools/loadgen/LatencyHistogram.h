@@ -0,0 +1,191 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <StandardDefines.h>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <iomanip>
+
+/**
+ * LatencyHistogram - HdrHistogram-compatible latency recorder
+ *
+ * Log-linear buckets with 2048 sub-buckets per power of two (three
+ * significant decimal digits) over 1 us .. ~1 hour, recorded in
+ * microseconds. WritePercentiles() emits the standard .hgrm percentile
+ * distribution (values in milliseconds, 5 ticks per half distance) that
+ * HdrHistogram's plotter and wrk2 tooling read, so runs from different
+ * builds can be diffed and plotted together.
+ */
+class LatencyHistogram {
+    Private Static constexpr Int subBucketHalfCountMagnitude = 10;
+    Private Static constexpr int64_t subBucketCount = int64_t(1) << (subBucketHalfCountMagnitude + 1);
+    Private Static constexpr int64_t subBucketHalfCount = subBucketCount / 2;
+    Private Static constexpr int64_t subBucketMask = subBucketCount - 1;
+    Private Static constexpr int64_t highestTrackableValue = int64_t(3600) * 1000 * 1000;
+
+    Private Vector<int64_t> counts_;
+    Private int64_t totalCount_ = 0;
+    Private int64_t maxValue_ = 0;
+    Private int64_t minValue_ = INT64_MAX;
+    Private double sum_ = 0.0;
+    Private double sumOfSquares_ = 0.0;
+
+    Private Static Int BucketIndex(int64_t value) {
+        Int pow2Ceiling = 64 - __builtin_clzll(static_cast<unsigned long long>(value | subBucketMask));
+        return pow2Ceiling - (subBucketHalfCountMagnitude + 1);
+    }
+
+    Private Static Size CountsIndex(int64_t value) {
+        Int bucketIndex = BucketIndex(value);
+        int64_t subBucketIndex = value >> bucketIndex;
+        return static_cast<Size>(((int64_t(bucketIndex) + 1) << subBucketHalfCountMagnitude) + (subBucketIndex - subBucketHalfCount));
+    }
+
+    Private Static int64_t ValueFromIndex(Size index) {
+        int64_t bucketIndex = int64_t(index >> subBucketHalfCountMagnitude) - 1;
+        int64_t subBucketIndex = int64_t(index & (subBucketHalfCount - 1)) + subBucketHalfCount;
+        if (bucketIndex < 0) {
+            subBucketIndex -= subBucketHalfCount;
+            bucketIndex = 0;
+        }
+        return subBucketIndex << bucketIndex;
+    }
+
+    /**
+     * Largest value that lands in the same bucket as value
+     */
+    Private Static int64_t HighestEquivalentValue(int64_t value) {
+        Int bucketIndex = BucketIndex(value);
+        int64_t subBucketIndex = value >> bucketIndex;
+        Int adjustedBucket = subBucketIndex >= subBucketCount ? bucketIndex + 1 : bucketIndex;
+        int64_t lowest = subBucketIndex << bucketIndex;
+        return lowest + (int64_t(1) << adjustedBucket) - 1;
+    }
+
+    Public LatencyHistogram() {
+        Int bucketsNeeded = 1;
+        int64_t smallestUntrackable = subBucketCount;
+        while (smallestUntrackable <= highestTrackableValue) {
+            smallestUntrackable <<= 1;
+            ++bucketsNeeded;
+        }
+        counts_.assign(static_cast<Size>((bucketsNeeded + 1) * subBucketHalfCount), 0);
+    }
+
+    /**
+     * Record one latency in microseconds (clamped to the trackable range)
+     */
+    Public Void Record(int64_t micros) {
+        if (micros < 0) {
+            micros = 0;
+        }
+        if (micros > highestTrackableValue) {
+            micros = highestTrackableValue;
+        }
+        ++counts_[CountsIndex(micros)];
+        ++totalCount_;
+        maxValue_ = micros > maxValue_ ? micros : maxValue_;
+        minValue_ = micros < minValue_ ? micros : minValue_;
+        sum_ += static_cast<double>(micros);
+        sumOfSquares_ += static_cast<double>(micros) * static_cast<double>(micros);
+    }
+
+    Public Void Add(const LatencyHistogram& other) {
+        for (Size i = 0; i < counts_.size(); ++i) {
+            counts_[i] += other.counts_[i];
+        }
+        totalCount_ += other.totalCount_;
+        maxValue_ = other.maxValue_ > maxValue_ ? other.maxValue_ : maxValue_;
+        minValue_ = other.minValue_ < minValue_ ? other.minValue_ : minValue_;
+        sum_ += other.sum_;
+        sumOfSquares_ += other.sumOfSquares_;
+    }
+
+    Public int64_t TotalCount() const {
+        return totalCount_;
+    }
+
+    Public int64_t Max() const {
+        return maxValue_;
+    }
+
+    Public double Mean() const {
+        return totalCount_ == 0 ? 0.0 : sum_ / totalCount_;
+    }
+
+    Public double StdDeviation() const {
+        if (totalCount_ == 0) {
+            return 0.0;
+        }
+        double mean = Mean();
+        double variance = sumOfSquares_ / totalCount_ - mean * mean;
+        return variance > 0 ? std::sqrt(variance) : 0.0;
+    }
+
+    /**
+     * Value (microseconds) at a percentile between 0 and 100
+     */
+    Public int64_t ValueAtPercentile(double percentile) const {
+        if (totalCount_ == 0) {
+            return 0;
+        }
+        double clamped = percentile > 100.0 ? 100.0 : percentile;
+        int64_t countAtPercentile = static_cast<int64_t>(std::ceil(clamped / 100.0 * totalCount_));
+        countAtPercentile = countAtPercentile < 1 ? 1 : countAtPercentile;
+        int64_t cumulative = 0;
+        for (Size i = 0; i < counts_.size(); ++i) {
+            cumulative += counts_[i];
+            if (cumulative >= countAtPercentile) {
+                int64_t value = HighestEquivalentValue(ValueFromIndex(i));
+                return value < maxValue_ ? value : maxValue_;
+            }
+        }
+        return maxValue_;
+    }
+
+    /**
+     * Write the percentile distribution in .hgrm format (values in milliseconds)
+     */
+    Public Void WritePercentiles(std::ostream& out) const {
+        constexpr Int ticksPerHalfDistance = 5;
+        out << std::right << std::setw(12) << "Value" << " " << std::setw(14) << "Percentile" << " "
+            << std::setw(10) << "TotalCount" << " " << std::setw(14) << "1/(1-Percentile)" << "\n\n";
+        out << std::fixed;
+        if (totalCount_ > 0) {
+            // Walk the distribution like HdrHistogram's percentile iterator: ticks get
+            // denser as the percentile approaches 100
+            double percentile = 0.0;
+            int64_t cumulative = 0;
+            Size index = 0;
+            while (true) {
+                int64_t countAtPercentile = static_cast<int64_t>(std::ceil(percentile / 100.0 * totalCount_));
+                countAtPercentile = countAtPercentile < 1 ? 1 : countAtPercentile;
+                while (cumulative < countAtPercentile && index < counts_.size()) {
+                    cumulative += counts_[index++];
+                }
+                int64_t value = HighestEquivalentValue(ValueFromIndex(index - 1));
+                value = value < maxValue_ ? value : maxValue_;
+                double fraction = static_cast<double>(cumulative) / totalCount_;
+                out << std::setw(12) << std::setprecision(3) << value / 1000.0 << " "
+                    << std::setw(14) << std::setprecision(12) << fraction << " "
+                    << std::setw(10) << cumulative << " ";
+                if (cumulative < totalCount_) {
+                    out << std::setw(14) << std::setprecision(2) << 1.0 / (1.0 - fraction);
+                }
+                out << "\n";
+                if (cumulative >= totalCount_) {
+                    break;
+                }
+                double halfDistance = std::pow(2.0, std::floor(std::log2(100.0 / (100.0 - percentile))) + 1);
+                percentile += 100.0 / (ticksPerHalfDistance * halfDistance);
+            }
+        }
+        out << std::setprecision(3)
+            << "#[Mean    = " << std::setw(12) << Mean() / 1000.0 << ", StdDeviation   = " << std::setw(12) << StdDeviation() / 1000.0 << "]\n"
+            << "#[Max     = " << std::setw(12) << maxValue_ / 1000.0 << ", Total count    = " << std::setw(12) << totalCount_ << "]\n"
+            << "#[Buckets = " << std::setw(12) << counts_.size() / subBucketHalfCount - 1 << ", SubBuckets     = " << std::setw(12) << subBucketCount << "]\n";
+    }
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -0,0 +1,376 @@
+/**
+ * springbootplusplus-web-loadgen - loopback HTTP load generator
+ *
+ * Drives a running server (desktop / POSIX build) over TCP with a fixed
+ * number of keep-alive connections, each with up to --pipeline requests in
+ * flight, and writes HdrHistogram .hgrm percentile files that can be diffed
+ * or plotted between builds.
+ *
+ * With --rate the generator is open-loop: request k of connection c is due at
+ * start + (k * connections + c) / rate, and its latency is measured from that
+ * intended send time rather than from when the socket was ready. A stalled
+ * server therefore inflates the recorded latencies instead of silently
+ * lowering the offered load (coordinated omission correction, as in wrk2).
+ * The uncorrected service times are written alongside for comparison.
+ * Without --rate every connection sends as fast as its pipeline allows.
+ *
+ * Example:
+ *   springbootplusplus-web-loadgen --port 8080 --path /api/user/42 \
+ *       --connections 8 --pipeline 4 --rate 20000 --duration 30 --out before
+ *   -> before.hgrm (corrected) and before.uncorrected.hgrm
+ *
+ * Built only with -DSPRINGBOOTPLUSPLUS_WEB_BUILD_LOADGEN=ON.
+ */
+
+#include <StandardDefines.h>
+#include <IServer.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include "LatencyHistogram.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct LoadGeneratorOptions {
+    StdString host = "127.0.0.1";
+    UInt port = DEFAULT_SERVER_PORT;
+    StdString method = "GET";
+    StdString path = "/";
+    StdString body;
+    Vector<StdString> headers;
+    UInt connections = 4;
+    UInt pipeline = 1;
+    Bool keepAlive = true;
+    double rate = 0.0;
+    double durationSeconds = 10.0;
+    double warmupSeconds = 1.0;
+    StdString output;
+};
+
+/**
+ * One client connection with its in-flight requests
+ */
+struct Connection {
+    Int fd = -1;
+    StdString writeBuffer;
+    Size written = 0;
+    StdString readBuffer;
+    // Intended and actual send times of requests awaiting a response, in order
+    std::deque<std::pair<Clock::time_point, Clock::time_point>> inFlight;
+    // Open loop: requests sent so far on this connection
+    uint64_t sent = 0;
+};
+
+Void PrintUsage() {
+    std::cout
+        << "Usage: springbootplusplus-web-loadgen [options]\n"
+        << "  --host ADDRESS        server address (default 127.0.0.1)\n"
+        << "  --port PORT           server port (default " << DEFAULT_SERVER_PORT << ")\n"
+        << "  --method METHOD       request method (default GET)\n"
+        << "  --path PATH           request target (default /)\n"
+        << "  --body TEXT           request body\n"
+        << "  --header 'K: V'       extra request header (repeatable)\n"
+        << "  --connections N       concurrent connections (default 4)\n"
+        << "  --pipeline N          requests in flight per connection (default 1)\n"
+        << "  --no-keepalive        one request per connection (implies --pipeline 1)\n"
+        << "  --rate R              total requests per second; open loop with coordinated\n"
+        << "                        omission correction (default: closed loop, as fast as possible)\n"
+        << "  --duration SECONDS    measured duration (default 10)\n"
+        << "  --warmup SECONDS      unrecorded warmup before measuring (default 1)\n"
+        << "  --out PREFIX          write PREFIX.hgrm and PREFIX.uncorrected.hgrm\n";
+}
+
+Bool ParseOptions(Int argc, char** argv, LoadGeneratorOptions& options) {
+    for (Int i = 1; i < argc; ++i) {
+        StdString arg = argv[i];
+        auto next = [&](StdString& value) {
+            if (i + 1 >= argc) {
+                std::cerr << "Missing value for " << arg << std::endl;
+                return false;
+            }
+            value = argv[++i];
+            return true;
+        };
+        StdString value;
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return false;
+        } else if (arg == "--no-keepalive") {
+            options.keepAlive = false;
+        } else if (!next(value)) {
+            return false;
+        } else if (arg == "--host") {
+            options.host = value;
+        } else if (arg == "--port") {
+            options.port = static_cast<UInt>(std::stoul(value));
+        } else if (arg == "--method") {
+            options.method = value;
+        } else if (arg == "--path") {
+            options.path = value;
+        } else if (arg == "--body") {
+            options.body = value;
+        } else if (arg == "--header") {
+            options.headers.push_back(value);
+        } else if (arg == "--connections") {
+            options.connections = static_cast<UInt>(std::stoul(value));
+        } else if (arg == "--pipeline") {
+            options.pipeline = static_cast<UInt>(std::stoul(value));
+        } else if (arg == "--rate") {
+            options.rate = std::stod(value);
+        } else if (arg == "--duration") {
+            options.durationSeconds = std::stod(value);
+        } else if (arg == "--warmup") {
+            options.warmupSeconds = std::stod(value);
+        } else if (arg == "--out") {
+            options.output = value;
+        } else {
+            std::cerr << "Unknown option " << arg << std::endl;
+            PrintUsage();
+            return false;
+        }
+    }
+    if (options.connections == 0 || options.pipeline == 0) {
+        std::cerr << "--connections and --pipeline must be at least 1" << std::endl;
+        return false;
+    }
+    if (!options.keepAlive) {
+        options.pipeline = 1;
+    }
+    return true;
+}
+
+StdString BuildRequest(const LoadGeneratorOptions& options) {
+    StdString request = options.method + " " + options.path + " HTTP/1.1\r\n";
+    request += "Host: " + options.host + ":" + std::to_string(options.port) + "\r\n";
+    request += options.keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    for (CStdString& header : options.headers) {
+        request += header + "\r\n";
+    }
+    if (!options.body.empty()) {
+        request += "Content-Length: " + std::to_string(options.body.length()) + "\r\n";
+    }
+    request += "\r\n" + options.body;
+    return request;
+}
+
+Int Connect(const LoadGeneratorOptions& options) {
+    Int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(options.port));
+    if (::inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1 ||
+        ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    Int noDelay = 1;
+    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+Bool StartsWithIgnoreCase(CStdString& text, Size position, const char* prefix) {
+    for (Size i = 0; prefix[i] != '\0'; ++i) {
+        if (position + i >= text.length() || std::tolower(static_cast<UChar>(text[position + i])) != prefix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Length of the first complete response in buffer, or 0 if it is incomplete
+ *
+ * @param status Set to the response status code
+ */
+Size CompleteResponseLength(CStdString& buffer, Int& status) {
+    Size headerEnd = buffer.find("\r\n\r\n");
+    if (headerEnd == StdString::npos) {
+        return 0;
+    }
+    Size space = buffer.find(' ');
+    status = space != StdString::npos && space < headerEnd ? std::atoi(buffer.c_str() + space + 1) : 0;
+    Size contentLength = 0;
+    for (Size line = buffer.find("\r\n"); line != StdString::npos && line < headerEnd; line = buffer.find("\r\n", line + 2)) {
+        if (StartsWithIgnoreCase(buffer, line + 2, "content-length:")) {
+            contentLength = static_cast<Size>(std::strtoull(buffer.c_str() + line + 2 + 15, nullptr, 10));
+            break;
+        }
+    }
+    Size total = headerEnd + 4 + contentLength;
+    return buffer.length() >= total ? total : 0;
+}
+
+Void WriteHistogram(const LatencyHistogram& histogram, CStdString& file) {
+    std::ofstream out(file);
+    histogram.WritePercentiles(out);
+    std::cout << "wrote " << file << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    LoadGeneratorOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+
+    const StdString request = BuildRequest(options);
+    Vector<Connection> connections(options.connections);
+    for (Connection& connection : connections) {
+        connection.fd = Connect(options);
+        if (connection.fd < 0) {
+            std::cerr << "Cannot connect to " << options.host << ":" << options.port << ": " << std::strerror(errno) << std::endl;
+            return 1;
+        }
+    }
+
+    LatencyHistogram corrected;
+    LatencyHistogram uncorrected;
+    uint64_t errors = 0;
+    uint64_t socketErrors = 0;
+    Vector<pollfd> pollFds(connections.size());
+
+    const Clock::time_point start = Clock::now();
+    const Clock::time_point measureFrom = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.warmupSeconds));
+    const Clock::time_point end = measureFrom + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.durationSeconds));
+    const Clock::time_point drainUntil = end + std::chrono::seconds(5);
+    const double interval = options.rate > 0 ? options.connections / options.rate : 0.0;
+
+    auto intendedSendTime = [&](Size index, const Connection& connection) {
+        double offset = (static_cast<double>(connection.sent) + static_cast<double>(index) / options.connections) * interval;
+        return start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(offset));
+    };
+
+    while (true) {
+        Clock::time_point now = Clock::now();
+        Bool anyInFlight = false;
+        for (const Connection& connection : connections) {
+            anyInFlight = anyInFlight || !connection.inFlight.empty();
+        }
+        if (now >= drainUntil || (now >= end && !anyInFlight)) {
+            break;
+        }
+
+        // Queue every request that is due and fits in the pipeline
+        Clock::time_point wakeAt = end;
+        for (Size i = 0; i < connections.size(); ++i) {
+            Connection& connection = connections[i];
+            while (now < end && connection.inFlight.size() < options.pipeline) {
+                Clock::time_point intended = interval > 0 ? intendedSendTime(i, connection) : now;
+                if (intended > now) {
+                    wakeAt = intended < wakeAt ? intended : wakeAt;
+                    break;
+                }
+                connection.writeBuffer += request;
+                connection.inFlight.emplace_back(intended, now);
+                ++connection.sent;
+            }
+            pollFds[i].fd = connection.fd;
+            pollFds[i].events = POLLIN | (connection.written < connection.writeBuffer.length() ? POLLOUT : 0);
+            pollFds[i].revents = 0;
+        }
+
+        Int timeoutMillis = static_cast<Int>(std::chrono::duration_cast<std::chrono::milliseconds>(wakeAt - now).count());
+        ::poll(pollFds.data(), pollFds.size(), timeoutMillis < 0 ? 0 : (timeoutMillis > 10 ? 10 : timeoutMillis));
+
+        for (Size i = 0; i < connections.size(); ++i) {
+            Connection& connection = connections[i];
+            if (pollFds[i].revents & POLLOUT) {
+                ssize_t n = ::send(connection.fd, connection.writeBuffer.data() + connection.written,
+                                   connection.writeBuffer.length() - connection.written, MSG_NOSIGNAL);
+                if (n > 0) {
+                    connection.written += static_cast<Size>(n);
+                    if (connection.written == connection.writeBuffer.length()) {
+                        connection.writeBuffer.clear();
+                        connection.written = 0;
+                    }
+                }
+            }
+            if (!(pollFds[i].revents & (POLLIN | POLLHUP | POLLERR))) {
+                continue;
+            }
+            char chunk[16384];
+            ssize_t n = ::recv(connection.fd, chunk, sizeof(chunk), 0);
+            if (n > 0) {
+                connection.readBuffer.append(chunk, static_cast<Size>(n));
+            }
+            Clock::time_point received = Clock::now();
+            Int status = 0;
+            Size length;
+            while (!connection.inFlight.empty() && (length = CompleteResponseLength(connection.readBuffer, status)) > 0) {
+                connection.readBuffer.erase(0, length);
+                auto times = connection.inFlight.front();
+                connection.inFlight.pop_front();
+                if (times.first >= measureFrom && times.first < end) {
+                    corrected.Record(std::chrono::duration_cast<std::chrono::microseconds>(received - times.first).count());
+                    uncorrected.Record(std::chrono::duration_cast<std::chrono::microseconds>(received - times.second).count());
+                    if (status < 200 || status >= 400) {
+                        ++errors;
+                    }
+                }
+            }
+            Bool closed = n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK);
+            if (closed || (!options.keepAlive && connection.inFlight.empty())) {
+                // Requests lost with the connection are errors; reconnect and carry on
+                if (!connection.inFlight.empty()) {
+                    socketErrors += connection.inFlight.size();
+                }
+                ::close(connection.fd);
+                uint64_t sent = connection.sent;
+                connection = Connection();
+                connection.sent = sent;
+                connection.fd = Connect(options);
+                if (connection.fd < 0) {
+                    std::cerr << "Reconnect failed: " << std::strerror(errno) << std::endl;
+                    return 1;
+                }
+            }
+        }
+    }
+
+    for (Connection& connection : connections) {
+        ::close(connection.fd);
+    }
+
+    double seconds = options.durationSeconds;
+    std::cout << std::fixed << std::setprecision(3)
+              << (options.rate > 0 ? "open loop, " : "closed loop, ") << options.connections << " connection(s), pipeline "
+              << options.pipeline << (options.keepAlive ? ", keep-alive" : ", no keep-alive") << "\n"
+              << "requests " << corrected.TotalCount() << " in " << seconds << " s (" << corrected.TotalCount() / seconds
+              << " req/s), error responses " << errors << ", socket errors " << socketErrors << "\n"
+              << "latency (ms)        p50        p90        p99       p999        max\n"
+              << "corrected   " << std::setw(11) << corrected.ValueAtPercentile(50) / 1000.0
+              << std::setw(11) << corrected.ValueAtPercentile(90) / 1000.0
+              << std::setw(11) << corrected.ValueAtPercentile(99) / 1000.0
+              << std::setw(11) << corrected.ValueAtPercentile(99.9) / 1000.0
+              << std::setw(11) << corrected.Max() / 1000.0 << "\n"
+              << "uncorrected " << std::setw(11) << uncorrected.ValueAtPercentile(50) / 1000.0
+              << std::setw(11) << uncorrected.ValueAtPercentile(90) / 1000.0
+              << std::setw(11) << uncorrected.ValueAtPercentile(99) / 1000.0
+              << std::setw(11) << uncorrected.ValueAtPercentile(99.9) / 1000.0
+              << std::setw(11) << uncorrected.Max() / 1000.0 << std::endl;
+
+    if (!options.output.empty()) {
+        WriteHistogram(corrected, options.output + ".hgrm");
+        WriteHistogram(uncorrected, options.output + ".uncorrected.hgrm");
+    }
+    return 0;
+}